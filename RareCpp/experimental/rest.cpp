@@ -1,8 +1,28 @@
 #include <rarecpp/json.h>
 #include <rarecpp/reflect.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
 #include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -21,6 +41,8 @@ namespace Http
         PATCH,
         DELETE
     };
+
+    inline constexpr size_t TotalMethods = size_t(Method::DELETE)+1;
 }
 
 std::ostream & operator<<(std::ostream & os, Http::Method method)
@@ -42,15 +64,53 @@ namespace Rest
         std::string_view value;
     };
 
-    struct Endpoint
+    // Names the arguments of an endpoint, e.g. Rest::Args{"id", "name"}; named arguments bind to the path parameters of the same name,
+    // when more than one argument is left over the payload must be a JSON object whose fields bind to the remaining arguments by name
+    template <typename ... Names>
+    struct Args
+    {
+        std::array<std::string_view, sizeof...(Names)> names;
+    };
+    template <typename ... Names> Args(Names...) -> Args<Names...>;
+
+    class InvalidArgument : public std::invalid_argument
+    {
+    public:
+        InvalidArgument(const std::string & message) : std::invalid_argument(message) {}
+    };
+
+    // An in-process stand-in for an HTTP request
+    struct Request
     {
         Http::Method method;
-        std::string uri;
-        size_t controllerIndex;
-        size_t memberIndex;
-        size_t overloadIndex;
+        std::string_view uri;
+        std::string_view payload {};
     };
 
+    struct Response
+    {
+        int status;
+        std::string body {};
+    };
+
+    inline constexpr size_t None = std::numeric_limits<size_t>::max();
+
+    template <typename Controller> constexpr std::string_view ControllerUri()
+    {
+        if constexpr ( RareTs::Reflect<Controller>::Notes::template hasNote<Rest::Uri>() )
+            return RareTs::Reflect<Controller>::Notes::template getNote<Rest::Uri>().value;
+        else
+        {
+            std::string_view typeStr = RareTs::toStr<Controller>();
+            if ( typeStr.substr(0, 7) == "struct " )
+                typeStr.remove_prefix(7);
+            else if ( typeStr.substr(0, 6) == "class " )
+                typeStr.remove_prefix(6);
+
+            return typeStr;
+        }
+    }
+
     template <size_t controllerIndex, typename Controller, typename Member, bool overloaded = false, size_t overloadIndex = 0> struct EndpointDescr;
 
     template <
@@ -64,18 +124,28 @@ namespace Rest
         static constexpr size_t MemberIndex = Member::index;
         static constexpr size_t OverloadIndex = overloadIndex;
 
+        using MemberType = Member;
+        static constexpr auto function = RareTs::Function(Member::pointer);
+
         static constexpr Http::Method Method() {
             if constexpr ( Member::template hasNote<Http::Method>() )
                 return Member::template getNote<Http::Method>();
             else
                 return Http::Method::GET;
         }
+        static constexpr std::string_view ControllerUri() { return Rest::ControllerUri<Controller>(); }
         static constexpr std::string_view Uri() {
             if constexpr ( Member::template hasNote<Rest::Uri>() )
                 return Member::template getNote<Rest::Uri>().value;
             else
                 return Member::name;
         }
+        static constexpr auto ArgumentNames() {
+            if constexpr ( Member::template hasNote<Rest::Args>() )
+                return Member::template getNote<Rest::Args>().names;
+            else
+                return std::array<std::string_view, 0> {};
+        }
     };
 
     template <
@@ -89,18 +159,21 @@ namespace Rest
         static constexpr size_t MemberIndex = Member::index;
         static constexpr size_t OverloadIndex = overloadIndex;
 
+        using MemberType = Member;
         static constexpr auto overload = typename Member::Overloads::template Overload<overloadIndex>{};
         using Overload = RareTs::remove_cvref_t<decltype(overload)>;
+        static constexpr auto function = RareTs::Function(overload.pointer);
 
         static constexpr auto Method() {
             if constexpr ( Overload::template hasNote<Http::Method>() )
                 return overload.template getNote<Http::Method>();
-            else if constexpr ( Member::template hasNote<Http::Method> )
+            else if constexpr ( Member::template hasNote<Http::Method>() )
                 return Member::template getNote<Http::Method>();
             else
                 return Http::Method::GET;
         }
-        static constexpr auto Uri() {
+        static constexpr std::string_view ControllerUri() { return Rest::ControllerUri<Controller>(); }
+        static constexpr std::string_view Uri() {
             if constexpr ( Overload::template hasNote<Rest::Uri>() )
                 return overload.template getNote<Rest::Uri>().value;
             else if constexpr ( Member::template hasNote<Rest::Uri>() )
@@ -108,11 +181,573 @@ namespace Rest
             else
                 return Member::name;
         }
+        static constexpr auto ArgumentNames() {
+            if constexpr ( Overload::template hasNote<Rest::Args>() )
+                return overload.template getNote<Rest::Args>().names;
+            else if constexpr ( Member::template hasNote<Rest::Args>() )
+                return Member::template getNote<Rest::Args>().names;
+            else
+                return std::array<std::string_view, 0> {};
+        }
     };
     
     template <typename Member, typename = RareTs::enable_if_member_t<Member>>
     struct IsRestEndpoint : std::bool_constant<(Member::isFunction || Member::Overloads::totalArgumentSets > 0)> {};
 
+    // Removes and returns the next non-empty '/' separated segment of path (or returns an empty view if there are none)
+    constexpr std::string_view nextSegment(std::string_view & path)
+    {
+        while ( !path.empty() && path.front() == '/' )
+            path.remove_prefix(1);
+
+        std::string_view segment = path.substr(0, path.find('/'));
+        path.remove_prefix(segment.size());
+        return segment;
+    }
+
+    constexpr bool isParameter(std::string_view segment) { return segment.size() >= 2 && segment.front() == '{' && segment.back() == '}'; }
+
+    struct RouteSource
+    {
+        Http::Method method;
+        std::string_view controllerUri;
+        std::string_view uri;
+    };
+
+    struct RouteNode
+    {
+        std::string_view segment {};
+        bool isParameter = false;
+        size_t firstChild = None;
+        size_t nextSibling = None;
+        std::array<size_t, Http::TotalMethods> endpoints {};
+
+        constexpr RouteNode() { for ( auto & endpoint : endpoints ) endpoint = None; }
+    };
+
+    // A trie over the path segments of every endpoint, parameter segments (e.g. "{id}") match any single segment of a request uri
+    template <size_t TotalNodes, size_t MaxParameters>
+    struct Router
+    {
+        struct Match
+        {
+            size_t endpoint = None;
+            size_t totalParameters = 0;
+            std::array<std::string_view, MaxParameters> parameters {}; // Views into the request uri
+        };
+
+        std::array<RouteNode, TotalNodes> nodes {};
+        size_t totalNodes = 1;
+
+        constexpr size_t child(size_t parent, std::string_view segment)
+        {
+            bool parameter = isParameter(segment);
+            size_t last = None;
+            for ( size_t i = nodes[parent].firstChild; i != None; i = nodes[i].nextSibling )
+            {
+                if ( parameter ? nodes[i].isParameter : !nodes[i].isParameter && nodes[i].segment == segment )
+                    return i;
+
+                last = i;
+            }
+
+            size_t added = totalNodes++;
+            nodes[added].segment = segment;
+            nodes[added].isParameter = parameter;
+            if ( last == None )
+                nodes[parent].firstChild = added;
+            else
+                nodes[last].nextSibling = added;
+
+            return added;
+        }
+
+        constexpr void add(const RouteSource & source, size_t endpoint)
+        {
+            size_t node = 0;
+            for ( std::string_view path : { source.controllerUri, source.uri } )
+            {
+                for ( std::string_view segment = nextSegment(path); !segment.empty(); segment = nextSegment(path) )
+                    node = child(node, segment);
+            }
+
+            size_t & target = nodes[node].endpoints[size_t(source.method)];
+            if ( target != None )
+                throw std::logic_error("Multiple endpoints have the same method and uri"); // Fails compilation when routes are built at compile time
+
+            target = endpoint;
+        }
+
+        constexpr bool match(size_t node, std::string_view path, Http::Method method, Match & result) const
+        {
+            std::string_view segment = nextSegment(path);
+            if ( segment.empty() )
+            {
+                result.endpoint = nodes[node].endpoints[size_t(method)];
+                return result.endpoint != None;
+            }
+
+            for ( size_t i = nodes[node].firstChild; i != None; i = nodes[i].nextSibling ) // Literal segments take precedence over parameters
+            {
+                if ( !nodes[i].isParameter && nodes[i].segment == segment && match(i, path, method, result) )
+                    return true;
+            }
+            for ( size_t i = nodes[node].firstChild; i != None; i = nodes[i].nextSibling )
+            {
+                if ( nodes[i].isParameter && result.totalParameters < MaxParameters )
+                {
+                    result.parameters[result.totalParameters++] = segment;
+                    if ( match(i, path, method, result) )
+                        return true;
+
+                    --result.totalParameters;
+                }
+            }
+            return false;
+        }
+
+        constexpr Match match(Http::Method method, std::string_view uri) const
+        {
+            Match result {};
+            if ( !match(0, uri.substr(0, uri.find('?')), method, result) )
+                result.endpoint = None;
+
+            return result;
+        }
+    };
+
+    template <typename Endpoints, size_t ... Is> constexpr auto routeSources(std::index_sequence<Is...>)
+    {
+        return std::array<RouteSource, sizeof...(Is)> {
+            RouteSource { std::tuple_element_t<Is, Endpoints>::Method(), std::tuple_element_t<Is, Endpoints>::ControllerUri(),
+                std::tuple_element_t<Is, Endpoints>::Uri() }...
+        };
+    }
+
+    template <typename Sources> constexpr size_t totalRouteNodes(const Sources & sources)
+    {
+        size_t total = 1;
+        for ( const auto & source : sources )
+        {
+            for ( std::string_view path : { source.controllerUri, source.uri } )
+            {
+                while ( !nextSegment(path).empty() )
+                    ++total;
+            }
+        }
+        return total;
+    }
+
+    template <typename Sources> constexpr size_t maxRouteParameters(const Sources & sources)
+    {
+        size_t max = 0;
+        for ( const auto & source : sources )
+        {
+            size_t total = 0;
+            for ( std::string_view path : { source.controllerUri, source.uri } )
+            {
+                for ( std::string_view segment = nextSegment(path); !segment.empty(); segment = nextSegment(path) )
+                    total += isParameter(segment) ? 1 : 0;
+            }
+            max = total > max ? total : max;
+        }
+        return max;
+    }
+
+    template <typename Endpoints> constexpr auto makeRouter()
+    {
+        constexpr auto sources = routeSources<Endpoints>(std::make_index_sequence<std::tuple_size_v<Endpoints>>());
+        Router<totalRouteNodes(sources), maxRouteParameters(sources)> router {};
+        for ( size_t i=0; i<sources.size(); ++i )
+            router.add(sources[i], i);
+
+        return router;
+    }
+
+    // Where each argument of an endpoint is bound from, the index of a path parameter or None for the payload; unnamed arguments bind to
+    // path parameters in order
+    template <typename Endpoint>
+    struct Binding
+    {
+        using Arguments = RareTs::arguments_t<typename decltype(Endpoint::function)::pointer_type>;
+
+        static constexpr size_t TotalArguments = std::tuple_size_v<Arguments>;
+
+        static constexpr auto names = Endpoint::ArgumentNames();
+
+        static_assert(names.empty() || names.size() == TotalArguments, "Rest::Args must name every argument of an endpoint");
+
+        static constexpr auto sources = [](){
+            std::array<size_t, TotalArguments> result {};
+            for ( auto & source : result )
+                source = None;
+
+            size_t parameter = 0;
+            for ( std::string_view path : { Endpoint::ControllerUri(), Endpoint::Uri() } )
+            {
+                for ( std::string_view segment = nextSegment(path); !segment.empty(); segment = nextSegment(path) )
+                {
+                    if ( !isParameter(segment) )
+                        continue;
+                    else if ( names.empty() )
+                    {
+                        if ( parameter < TotalArguments )
+                            result[parameter] = parameter;
+                    }
+                    else
+                    {
+                        size_t i = 0;
+                        while ( i < names.size() && names[i] != segment.substr(1, segment.size()-2) )
+                            ++i;
+
+                        if ( i == names.size() )
+                            throw std::logic_error("Path parameter is not named by Rest::Args"); // Fails compilation
+
+                        result[i] = parameter;
+                    }
+                    ++parameter;
+                }
+            }
+            return result;
+        }();
+
+        static constexpr size_t TotalPayloadArguments = [](){
+            size_t total = 0;
+            for ( size_t source : sources )
+                total += source == None ? 1 : 0;
+            return total;
+        }();
+
+        static_assert(TotalPayloadArguments < 2 || !names.empty(), "Endpoints with several payload arguments must name them using Rest::Args");
+    };
+
+    // Binds an argument from text without copying it into a stream, isJson is false for path parameters & whole payloads (read verbatim)
+    template <typename T> T readArgument(std::string_view text, bool isJson)
+    {
+        if constexpr ( std::is_same_v<std::string_view, T> || std::is_same_v<std::string, T> )
+        {
+            if ( isJson )
+            {
+                if ( text.size() < 2 || text.front() != '"' || text.back() != '"' )
+                    throw InvalidArgument("Expected a string but found: " + std::string(text));
+                else if ( text.find('\\') == std::string_view::npos )
+                    text = text.substr(1, text.size()-2);
+                else if constexpr ( std::is_same_v<std::string, T> )
+                    return Json::read<std::string>(text);
+                else
+                    throw InvalidArgument("Escaped strings cannot be viewed in place: " + std::string(text));
+            }
+            return T(text);
+        }
+        else if constexpr ( std::is_same_v<bool, T> )
+        {
+            if ( text == "true" )
+                return true;
+            else if ( text == "false" )
+                return false;
+            else
+                throw InvalidArgument("Expected a bool but found: " + std::string(text));
+        }
+        else if constexpr ( std::is_arithmetic_v<T> )
+        {
+            T value {};
+            auto [end, ec] = std::from_chars(text.data(), text.data()+text.size(), value);
+            if ( ec != std::errc() || end != text.data()+text.size() )
+                throw InvalidArgument("Expected a number but found: " + std::string(text));
+
+            return value;
+        }
+        else
+            return Json::read<T>(text);
+    }
+
+    // Controller notes selecting whether the engine may call into a controller concurrently, controllers are Reentrant unless noted
+    struct ReentrantType {};
+    inline constexpr ReentrantType Reentrant {};
+
+    struct SerializedType {}; // Endpoints of the controller are called one at a time, a task returned by an endpoint holds the controller until it completes
+    inline constexpr SerializedType Serialized {};
+
+    // A work-stealing pool: each worker runs work from the back of its own queue and steals from the front of other workers' queues when
+    // its own is empty; work submitted from a worker is queued on that worker, work submitted from elsewhere is spread round-robin
+    class ThreadPool
+    {
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> work;
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers {};
+        std::vector<std::thread> threads {};
+        std::mutex sleepMutex {}; // Only taken to go to sleep or to wake sleeping workers
+        std::condition_variable wake {};
+        std::atomic<size_t> pending = 0; // Work submitted and not yet taken by a worker
+        std::atomic<size_t> sleeping = 0;
+        std::atomic<bool> stopping = false;
+        std::atomic<size_t> next = 0;
+
+        static inline thread_local ThreadPool* currentPool = nullptr;
+        static inline thread_local size_t currentWorker = 0;
+
+        bool tryTake(size_t index, std::function<void()> & task)
+        {
+            for ( size_t i=0; i<workers.size(); ++i )
+            {
+                Worker & worker = *workers[(index+i) % workers.size()];
+                std::lock_guard lock(worker.mutex);
+                if ( !worker.work.empty() )
+                {
+                    if ( i == 0 )
+                    {
+                        task = std::move(worker.work.back());
+                        worker.work.pop_back();
+                    }
+                    else
+                    {
+                        task = std::move(worker.work.front());
+                        worker.work.pop_front();
+                    }
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void run(size_t index)
+        {
+            currentPool = this;
+            currentWorker = index;
+            std::function<void()> task {};
+            for ( ;; )
+            {
+                if ( tryTake(index, task) )
+                {
+                    pending.fetch_sub(1);
+                    task();
+                    task = nullptr;
+                }
+                else if ( pending.load() > 0 ) // Work is still being queued
+                    std::this_thread::yield();
+                else
+                {
+                    std::unique_lock lock(sleepMutex);
+                    sleeping.fetch_add(1); // Ordered against submit's increment of pending, so either submit sees the sleeper or the sleeper sees the work
+                    wake.wait(lock, [&]{ return stopping.load() || pending.load() > 0; });
+                    sleeping.fetch_sub(1);
+                    if ( stopping.load() && pending.load() == 0 )
+                        return;
+                }
+            }
+        }
+
+    public:
+        ThreadPool(size_t totalThreads = 0)
+        {
+            totalThreads = totalThreads > 0 ? totalThreads : std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+            for ( size_t i=0; i<totalThreads; ++i )
+                workers.push_back(std::make_unique<Worker>());
+
+            for ( size_t i=0; i<totalThreads; ++i )
+                threads.emplace_back([this, i]{ run(i); });
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool & operator=(const ThreadPool &) = delete;
+
+        // Runs any work already submitted then joins the workers
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard lock(sleepMutex);
+                stopping.store(true);
+            }
+            wake.notify_all();
+            for ( auto & thread : threads )
+                thread.join();
+        }
+
+        size_t size() const { return workers.size(); }
+
+        template <typename Work> void submit(Work && work)
+        {
+            size_t index = currentPool == this ? currentWorker : next.fetch_add(1, std::memory_order_relaxed) % workers.size();
+            pending.fetch_add(1);
+            {
+                std::lock_guard lock(workers[index]->mutex);
+                workers[index]->work.emplace_back(std::forward<Work>(work));
+            }
+            if ( sleeping.load() > 0 )
+            {
+                { std::lock_guard lock(sleepMutex); } // A worker between checking for work and waiting holds sleepMutex
+                wake.notify_one();
+            }
+        }
+
+        // Submits work to the pool of the calling worker, returns false without running work if not called from a worker of a pool
+        template <typename Work> static bool submitToCurrent(Work && work)
+        {
+            if ( currentPool == nullptr )
+                return false;
+
+            currentPool->submit(std::forward<Work>(work));
+            return true;
+        }
+
+        // Awaiting yield() resumes the awaiting coroutine later on a worker of the current pool, letting queued work run in between;
+        // this does not suspend when awaited outside of a pool
+        static auto yield()
+        {
+            struct Awaiter
+            {
+                bool await_ready() const noexcept { return currentPool == nullptr; }
+                void await_suspend(std::coroutine_handle<> awaiting) const { currentPool->submit([awaiting]{ awaiting.resume(); }); }
+                void await_resume() const noexcept {}
+            };
+            return Awaiter{};
+        }
+    };
+
+    namespace detail
+    {
+        template <typename T> struct TaskResult
+        {
+            std::optional<T> value {};
+
+            void return_value(T result) { value.emplace(std::move(result)); }
+            T get() { return std::move(*value); }
+        };
+
+        template <> struct TaskResult<void>
+        {
+            void return_void() {}
+            void get() {}
+        };
+
+        class SerialLock // Acquired by co_await lock() and released by unlock() on any thread, waiting coroutines acquire the lock in order
+        {
+            std::mutex mutex {};
+            bool held = false; // Guarded by mutex
+            std::deque<std::coroutine_handle<>> waiting {}; // Guarded by mutex
+
+        public:
+            auto lock()
+            {
+                struct Awaiter
+                {
+                    SerialLock & serialLock;
+
+                    bool await_ready() const noexcept { return false; }
+                    bool await_suspend(std::coroutine_handle<> awaiting)
+                    {
+                        std::lock_guard guard(serialLock.mutex);
+                        if ( !serialLock.held )
+                        {
+                            serialLock.held = true;
+                            return false;
+                        }
+                        serialLock.waiting.push_back(awaiting);
+                        return true;
+                    }
+                    void await_resume() const noexcept {}
+                };
+                return Awaiter{*this};
+            }
+
+            void unlock()
+            {
+                std::coroutine_handle<> next {};
+                {
+                    std::lock_guard guard(mutex);
+                    if ( waiting.empty() )
+                    {
+                        held = false;
+                        return;
+                    }
+                    next = waiting.front(); // The lock passes directly to the next waiter
+                    waiting.pop_front();
+                }
+                if ( !ThreadPool::submitToCurrent([next]{ next.resume(); }) )
+                    next.resume();
+            }
+        };
+
+        struct Detached // A coroutine which starts immediately and frees itself on completion
+        {
+            struct promise_type
+            {
+                Detached get_return_object() noexcept { return {}; }
+                std::suspend_never initial_suspend() noexcept { return {}; }
+                std::suspend_never final_suspend() noexcept { return {}; }
+                void return_void() noexcept {}
+                void unhandled_exception() noexcept { std::terminate(); }
+            };
+        };
+    }
+
+    // A lazily started coroutine; endpoints may return Rest::Task<T> and co_await other tasks or Rest::ThreadPool::yield(), the engine responds
+    // with the result once the task completes (std::string_view arguments view the request, which must outlive the task)
+    template <typename T = void>
+    class Task
+    {
+    public:
+        struct promise_type : detail::TaskResult<T>
+        {
+            std::coroutine_handle<> continuation = std::noop_coroutine();
+            std::exception_ptr exception = nullptr;
+
+            Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            auto final_suspend() noexcept
+            {
+                struct Awaiter
+                {
+                    bool await_ready() noexcept { return false; }
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept { return handle.promise().continuation; }
+                    void await_resume() noexcept {}
+                };
+                return Awaiter{};
+            }
+            void unhandled_exception() { exception = std::current_exception(); }
+        };
+
+        Task(Task && other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+        Task & operator=(Task && other) = delete;
+        ~Task() { if ( handle ) handle.destroy(); }
+
+        auto operator co_await() noexcept
+        {
+            struct Awaiter
+            {
+                std::coroutine_handle<promise_type> handle;
+
+                bool await_ready() noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+                {
+                    handle.promise().continuation = awaiting;
+                    return handle;
+                }
+                T await_resume()
+                {
+                    if ( handle.promise().exception != nullptr )
+                        std::rethrow_exception(handle.promise().exception);
+
+                    return handle.promise().get();
+                }
+            };
+            return Awaiter{handle};
+        }
+
+    private:
+        explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    template <typename T> struct is_task : std::false_type {};
+    template <typename T> struct is_task<Task<T>> : std::true_type {};
+    template <typename T> inline constexpr bool is_task_v = is_task<T>::value;
+
     template <typename ... RestControllers>
     struct Engine
     {
@@ -126,17 +761,13 @@ namespace Rest
             });
         }
 
-        template <size_t C, typename Cntl, typename F, size_t ... Is> // combines overload endpoints // here Is is the note index
+        template <size_t C, typename Cntl, typename F, size_t ... Is> // combines overload endpoints // here Is is the argument set index
         static constexpr auto overloadEndpoint(std::index_sequence<Is...>) {
             return std::tuple { EndpointDescr<C, Cntl, F, true, Is>{}... };
         }
 
-        template <size_t C, typename Cntl, typename F, typename ... Ts> static constexpr auto overloadEndpoint(const std::tuple<Ts...> &) {
-            return overloadEndpoint<C, Cntl, F>(typename RareTs::type_mask<RareTs::is_overload_note, Ts...>::indexes{});
-        }
-
         template <size_t C, typename Cntl, typename F, std::enable_if_t<F::isOverloaded>* = nullptr>
-        static constexpr auto endpoint() { return overloadEndpoint<C, Cntl, F>(F::notes); }
+        static constexpr auto endpoint() { return overloadEndpoint<C, Cntl, F>(std::make_index_sequence<F::Overloads::totalArgumentSets>()); }
 
         template <size_t C, typename Cntl, typename F, std::enable_if_t<F::isFunction>* = nullptr>
         static constexpr auto endpoint() { return std::tuple { EndpointDescr<C, Cntl, F>{} }; }
@@ -149,12 +780,13 @@ namespace Rest
             return std::tuple_cat(controllerEndpoints<ControllerIndex>(controllerEndpointMembers<ControllerIndex>())...); // combines controller endpoints
         }
 
-        // While not currently in use, ControllerEndpoints represents an option for calculating all the endpoints at compile time
-        // Which could then be stuck in a hyper-constexpr-optimized URL router
+        // All endpoints are calculated at compile time and built into a URL router, so dispatching a request neither allocates nor scans endpoints
         using ControllerEndpoints = decltype(controllerEndpoints(std::make_index_sequence<TotalControllers>()));
 
         static constexpr size_t TotalEndpoints = std::tuple_size_v<ControllerEndpoints>;
 
+        static constexpr auto Routes = Rest::makeRouter<ControllerEndpoints>();
+
         static void Debug()
         {
             std::cout << "TotalControllers: " << TotalControllers << std::endl;
@@ -163,127 +795,173 @@ namespace Rest
             RareTs::forIndexes<TotalEndpoints>([](auto I) {
                 using Endpoint = std::tuple_element_t<decltype(I)::value, ControllerEndpoints>;
                 std::cout << "  " << RareTs::toStr<Endpoint>() << std::endl;
-                std::cout << "    " << Endpoint::Method() << " " << Endpoint::Uri() << std::endl;
+                std::cout << "    " << Endpoint::Method() << " " << Endpoint::ControllerUri() << " " << Endpoint::Uri() << std::endl;
             });
+            std::cout << "Route nodes: " << Routes.totalNodes << std::endl;
         }
 
+        template <size_t C> static constexpr bool IsSerialized =
+            RareTs::Reflect<std::tuple_element_t<C, RestControllerTuple>>::Notes::template hasNote<Rest::SerializedType>();
+
         RestControllerTuple restControllers;
-        std::vector<Rest::Endpoint> endpoints;
+        std::array<Rest::detail::SerialLock, TotalControllers> controllerLocks {};
 
-        Engine(RestControllers ... restControllers) : restControllers(std::forward_as_tuple(restControllers...))
-        {
-            RareTs::forIndexes<TotalControllers>([&](auto I) {
-                using RestControllerT = std::tuple_element_t<decltype(I)::value, std::tuple<RestControllers...>>;
+        Engine(RestControllers ... restControllers) : restControllers(std::forward_as_tuple(restControllers...)) {}
 
-                std::string controllerUri;
-                if constexpr ( RareTs::Reflect<RestControllerT>::Notes::template hasNote<Rest::Uri>() )
-                    controllerUri = std::string(RareTs::Reflect<RestControllerT>::Notes::template getNote<Rest::Uri>().value);
-                else
-                    controllerUri = "/" + Json::simplifyTypeStr(RareTs::toStr<RestControllerT>());
+        // Arguments are bound from the path parameters, any remaining argument is bound from the whole payload, or when several arguments remain
+        // from the fields of a JSON object payload (which is scanned once); numbers are parsed in place and strings are taken verbatim
+        // respond(Response) is called once the endpoint returns, or once the task returned by the endpoint completes
+        template <typename Respond> void dispatch(const Rest::Request & request, Respond && respond)
+        {
+            auto match = Routes.match(request.method, request.uri);
+            if ( match.endpoint == Rest::None )
+                return respond(Rest::Response{404});
 
-                RareTs::Reflect<RestControllerT>::Members::template forEach<IsRestEndpoint>([&](auto & member) {
-                    using Member = std::remove_reference_t<decltype(member)>;
-                    if constexpr ( Member::isFunction )
+            try
+            {
+                RareTs::forIndex<TotalEndpoints>(match.endpoint, [&](auto I) {
+                    using Endpoint = std::tuple_element_t<decltype(I)::value, ControllerEndpoints>;
+                    using Binding = Rest::Binding<Endpoint>;
+                    std::array<std::string_view, Binding::TotalArguments> arguments {};
+                    for ( size_t i=0; i<Binding::TotalArguments; ++i )
                     {
-                        constexpr auto i = std::remove_reference_t<decltype(I)>::value;
-                        Http::Method httpMethod = Http::Method::GET;
-                        if constexpr ( Member::template hasNote<Http::Method>() )
-                            httpMethod = Member::template getNote<Http::Method>();
-
-                        std::string endpointUri;
-                        if constexpr ( Member::template hasNote<Rest::Uri>() )
-                        {
-                            const auto & uri = Member::template getNote<Rest::Uri>().value;
-                            endpointUri = controllerUri + (controllerUri.back() == '/' || uri.front() == '/' ? "" : "/") + std::string(uri);
-                        }
-                        else
-                            endpointUri = controllerUri + (controllerUri.back() == '/' ? "" : "/") + Member::name;
-
-                        endpoints.push_back(Rest::Endpoint{httpMethod, endpointUri, i, Member::index, 0});
-                        //const auto & added = endpoints.back();
-                        //std::cout << "Registered method: " << added.method << " \"" << added.uri << "\" controller: " << added.controllerIndex << " member: " << added.memberIndex << std::endl;
+                        if ( Binding::sources[i] != Rest::None )
+                            arguments[i] = match.parameters[Binding::sources[i]];
+                        else if constexpr ( Binding::TotalPayloadArguments == 1 )
+                            arguments[i] = request.payload;
                     }
-                    else if constexpr ( RareTs::is_overloaded_v<RestControllerT, Member::index> )
+                    if constexpr ( Binding::TotalPayloadArguments > 1 )
                     {
-                        size_t overloadIndex = 0;
-                        Member::Overloads::forEach([&](auto overload) {
-                        constexpr auto i = std::remove_reference_t<decltype(I)>::value;
-                            using Ovl = decltype(overload);
-                            
-                            Http::Method httpMethod = Http::Method::GET;
-                            if constexpr ( Ovl::template hasNote<Http::Method>() )
-                                httpMethod = overload.template getNote<Http::Method>();
-
-                            std::string endpointUri;
-                            if constexpr ( Ovl::template hasNote<Rest::Uri>() )
+                        Json::readFields(request.payload, [&](std::string_view name, std::string_view value) {
+                            for ( size_t i=0; i<Binding::TotalArguments; ++i )
                             {
-                                const auto & uri = overload.template getNote<Rest::Uri>().value;
-                                endpointUri = controllerUri + (controllerUri.back() == '/' || uri.front() == '/' ? "" : "/") + std::string(uri);
+                                if ( Binding::sources[i] == Rest::None && Binding::names[i] == name )
+                                    arguments[i] = value;
                             }
-                            else
-                                endpointUri = controllerUri + (controllerUri.back() == '/' ? "" : "/") + Member::name;
-
-                            endpoints.push_back(Rest::Endpoint{httpMethod, endpointUri, i, Member::index, overloadIndex});
-                            //const auto & added = endpoints.back();
-                            //std::cout << "Registered method: " << added.method << " \"" << added.uri << "\" controller: " << added.controllerIndex << " member: " << added.memberIndex << " ovl: " << overloadIndex << std::endl;
-                            ++overloadIndex;
                         });
+                        for ( size_t i=0; i<Binding::TotalArguments; ++i )
+                        {
+                            if ( Binding::sources[i] == Rest::None && arguments[i].empty() )
+                                throw Rest::InvalidArgument("Payload is missing field: " + std::string(Binding::names[i]));
+                        }
                     }
+
+                    using Return = typename decltype(Endpoint::function)::Return;
+                    if constexpr ( IsSerialized<Endpoint::ControllerIndex> || Rest::is_task_v<Return> )
+                    { // Runs until the controller lock or the task first suspends, binding errors are responded to from within
+                        Engine::execute<Endpoint>(*this, arguments, std::forward<Respond>(respond));
+                    }
+                    else if constexpr ( std::is_void_v<Return> )
+                    {
+                        invoke<Endpoint>(arguments);
+                        respond(Rest::Response{200});
+                    }
+                    else
+                        respond(Rest::Response{200, Json::write(invoke<Endpoint>(arguments))});
                 });
-            });
+            }
+            catch ( const Rest::InvalidArgument & e )
+            {
+                respond(Rest::Response{400, e.what()});
+            }
+            catch ( const Json::Exception & e )
+            {
+                respond(Rest::Response{400, e.what()});
+            }
+            catch ( const std::exception & e )
+            {
+                respond(Rest::Response{500, e.what()});
+            }
+        }
+
+        // Handles the request on the calling thread, blocking until the task returned by an endpoint completes; this must not be called from
+        // a worker of a Rest::ThreadPool (use handleAsync there) as the task or a task holding a serialized controller may need that worker
+        Rest::Response handle(const Rest::Request & request)
+        {
+            std::promise<Rest::Response> response {};
+            auto future = response.get_future();
+            dispatch(request, [&](Rest::Response result) { response.set_value(std::move(result)); });
+            return future.get();
+        }
+
+        // Handles the request on a worker of pool and calls respond(Response) from there, the request must remain valid until respond is called
+        template <typename Respond> void handleAsync(Rest::ThreadPool & pool, const Rest::Request & request, Respond respond)
+        {
+            pool.submit([this, request, respond = std::move(respond)]() mutable { dispatch(request, std::move(respond)); });
         }
 
-        void handleRestEvent(Http::Method method, const std::string & uri, const std::string & /*payload*/ = "")
+        // Handles the request on a worker of pool, the request must remain valid until the response is ready
+        std::future<Rest::Response> handleAsync(Rest::ThreadPool & pool, const Rest::Request & request)
         {
-            for ( Rest::Endpoint endpoint : endpoints )
+            auto response = std::make_shared<std::promise<Rest::Response>>();
+            auto future = response->get_future();
+            handleAsync(pool, request, [response](Rest::Response result) { response->set_value(std::move(result)); });
+            return future;
+        }
+
+    private:
+        template <typename Endpoint, size_t TotalArguments>
+        decltype(auto) invoke(const std::array<std::string_view, TotalArguments> & arguments)
+        {
+            using Binding = Rest::Binding<Endpoint>;
+            auto argBuilder = [&](auto arg) {
+                using Type = RareTs::remove_cvref_t<typename decltype(arg)::type>;
+                constexpr size_t index = decltype(arg)::index;
+                constexpr bool isJson = Binding::sources[index] == Rest::None && Binding::TotalPayloadArguments > 1;
+                return Rest::readArgument<Type>(arguments[index], isJson);
+            };
+            if constexpr ( Endpoint::MemberType::isStatic )
+                return Endpoint::function.invoke(argBuilder);
+            else
+                return Endpoint::function.invoke(std::get<Endpoint::ControllerIndex>(restControllers), argBuilder);
+        }
+
+        // Calls endpoints of serialized controllers while holding the controller lock, and endpoints returning tasks until the task completes
+        template <typename Endpoint, size_t TotalArguments, typename Respond>
+        static Rest::detail::Detached execute(Engine & engine, std::array<std::string_view, TotalArguments> arguments, Respond respond)
+        {
+            constexpr bool serialized = IsSerialized<Endpoint::ControllerIndex>;
+            if constexpr ( serialized )
+                co_await engine.controllerLocks[Endpoint::ControllerIndex].lock();
+
+            using Return = typename decltype(Endpoint::function)::Return;
+            Rest::Response response {200};
+            try
             {
-                if ( method == endpoint.method && uri.substr(0, 12).compare(endpoint.uri.substr(0, 12)) == 0 )
+                if constexpr ( Rest::is_task_v<Return> )
                 {
-                    RareTs::forIndex<TotalControllers>(endpoint.controllerIndex, [&](auto I) {
-                        
-                        using RestControllerT = std::tuple_element_t<decltype(I)::value, std::tuple<RestControllers...>>;
-                        auto & restController = std::get<decltype(I)::value>(restControllers);
-                        auto argBuilder = [&](auto arg) {
-                            using Type = typename decltype(arg)::type;
-                            constexpr size_t index = decltype(arg)::index;
-                            std::string argInput = index == 0 ? "1" : "\"a\"";
-                            //std::cout << "Reading input argument: " << argInput << std::endl;
-                            Type type;
-                            std::stringstream(argInput) >> Json::in(type);
-                            //std::cout << "Read: " << RareTs::toStr<Type>() << ": " << type << std::endl;
-                            return type;
-                        };
-
-                        RareTs::Reflect<RestControllerT>::Members::at(endpoint.memberIndex, [&](auto & member) {
-                            using Member = std::remove_reference_t<decltype(member)>;
-                            if constexpr ( Member::isFunction ) 
-                            {
-                                using Function = RareTs::Function<typename Member::pointer_type>;
-                                Function function = Function(member.pointer);
-                                if constexpr ( Member::isStatic )
-                                    function.invoke(argBuilder);
-                                else
-                                    function.invoke(restController, argBuilder);
-                            }
-                            else if constexpr ( RareTs::is_overloaded_v<RestControllerT, Member::index> )
-                            {
-                                Member::Overloads::at(endpoint.overloadIndex, [&](auto overload) {
-                                    auto function = RareTs::Function(overload.pointer);
-                                    if constexpr ( Member::isStatic )
-                                        function.invoke(argBuilder);
-                                    else
-                                        function.invoke(restController, argBuilder);
-                                });
-                            }
-                        });
-                    });
+                    auto task = engine.invoke<Endpoint>(arguments); // Binds the arguments, the task starts when awaited
+                    if constexpr ( std::is_same_v<Rest::Task<void>, Return> )
+                        co_await task;
+                    else
+                        response.body = Json::write(co_await task);
                 }
+                else if constexpr ( std::is_void_v<Return> )
+                    engine.invoke<Endpoint>(arguments);
+                else
+                    response.body = Json::write(engine.invoke<Endpoint>(arguments));
+            }
+            catch ( const Rest::InvalidArgument & e )
+            {
+                response = Rest::Response{400, e.what()};
+            }
+            catch ( const Json::Exception & e )
+            {
+                response = Rest::Response{400, e.what()};
+            }
+            catch ( const std::exception & e )
+            {
+                response = Rest::Response{500, e.what()};
             }
+            if constexpr ( serialized )
+                engine.controllerLocks[Endpoint::ControllerIndex].unlock();
+
+            respond(std::move(response));
         }
     };
 }
 
-NOTE(TestController, Rest::Uri{"/my/path"})
+NOTE(TestController, Rest::Uri{"/my/path"}, Rest::Serialized)
 struct TestController
 {
     NOTE(sayHi,
@@ -314,7 +992,24 @@ struct TestController
         return 5;
     }
 
-    REFLECT_NOTED(TestController, sayHi, sayHiSolo, postit)
+    int count = 0;
+
+    NOTE(increment, Http::Method::POST)
+    int increment()
+    {
+        return ++count;
+    }
+
+    NOTE(incrementLater, Http::Method::POST)
+    Rest::Task<int> incrementLater()
+    {
+        int previous = count;
+        co_await Rest::ThreadPool::yield(); // The controller remains locked while suspended
+        count = previous+1;
+        co_return count;
+    }
+
+    REFLECT_NOTED(TestController, sayHi, sayHiSolo, postit, increment, incrementLater)
 };
 
 NOTE(AnotherTestController, Rest::Uri{"/my/other/path"})
@@ -335,17 +1030,148 @@ struct AnotherTestController
         return stuff + " modifications";
     }
 
-    REFLECT_NOTED(AnotherTestController, add, str)
+    NOTE(area,
+        Http::Method::POST,
+        Rest::Uri{"/area/{unit}"},
+        Rest::Args{"width", "height", "unit"})
+    static std::string area(double width, double height, std::string_view unit)
+    {
+        return std::to_string(int(width*height)) + std::string(unit);
+    }
+
+    static Rest::Task<int> half(int value)
+    {
+        co_await Rest::ThreadPool::yield();
+        co_return value/2;
+    }
+
+    NOTE(quarter,
+        Http::Method::GET,
+        Rest::Uri{"/quarter/{value}"})
+    static Rest::Task<int> quarter(int value)
+    {
+        co_return co_await half(co_await half(value));
+    }
+
+    REFLECT_NOTED(AnotherTestController, add, str, area, quarter)
 };
 
 Rest::Engine restEngine(TestController{}, AnotherTestController{});
 
 void rest()
 {
-    restEngine.handleRestEvent(Http::Method::GET, "/my/path/hello/1/a");
-    restEngine.handleRestEvent(Http::Method::GET, "/my/path/altHello/1");
+    struct Expectation
+    {
+        Rest::Request request;
+        int status;
+        std::string_view body; // Checked only for successful requests
+    };
+
+    const Expectation expectations[] {
+        { {Http::Method::GET, "/my/path/hello/1"}, 200, "" },
+        { {Http::Method::GET, "/my/path/hello/1/a"}, 200, "" },
+        { {Http::Method::GET, "/my/path/hi/2/b"}, 200, "" },
+        { {Http::Method::POST, "/my/path/postit", "stuff"}, 200, "5" },
+        { {Http::Method::GET, "/my/other/path/add/2/3?verbose"}, 200, "5" },
+        { {Http::Method::PATCH, "//my/other/path/str/", "stuff"}, 200, "\"stuff modifications\"" },
+        { {Http::Method::POST, "/my/other/path/area/cm", "{ \"height\": 2.5, \"ignored\": [1, {\"a\": \"}\"}], \"width\" : 4 }"}, 200, "\"10cm\"" },
+        { {Http::Method::GET, "/my/other/path/quarter/20"}, 200, "5" },
+        { {Http::Method::POST, "/my/path/increment"}, 200, "1" },
+        { {Http::Method::GET, "/my/path/altHello/1"}, 404, "" },
+        { {Http::Method::POST, "/my/other/path/add/2/3"}, 404, "" },
+        { {Http::Method::GET, "/my/other/path/add/2"}, 404, "" },
+        { {Http::Method::GET, "/my/other/path/add/x/3"}, 400, "" },
+        { {Http::Method::GET, "/my/other/path/add/2/3x"}, 400, "" },
+        { {Http::Method::GET, "/my/other/path/quarter/abc"}, 400, "" },
+        { {Http::Method::POST, "/my/other/path/area/cm", "{\"width\": 4}"}, 400, "" },
+        { {Http::Method::POST, "/my/other/path/area/cm", "{\"width\": 4, \"height\": "}, 400, "" },
+        { {Http::Method::POST, "/my/other/path/area/cm", "{\"width\": 4, \"a\": ], \"height\": 2}"}, 400, "" },
+    };
+
+    for ( const auto & expectation : expectations )
+    {
+        auto response = restEngine.handle(expectation.request);
+        bool passed = response.status == expectation.status && (response.status != 200 || response.body == expectation.body);
+        std::cout << (passed ? "  ok     " : "  FAILED ") << expectation.request.method << " " << expectation.request.uri
+            << " -> " << response.status << " " << response.body << std::endl;
+    }
+
+    Rest::ThreadPool pool(4);
+    const Rest::Request increment {Http::Method::POST, "/my/path/increment"}; // TestController is serialized
+    const Rest::Request incrementLater {Http::Method::POST, "/my/path/incrementLater"};
+    const Rest::Request quarter {Http::Method::GET, "/my/other/path/quarter/20"}; // Resumes on other workers
+    const Rest::Request invalidQuarter {Http::Method::GET, "/my/other/path/quarter/abc"};
+    std::vector<std::future<Rest::Response>> responses {};
+    for ( size_t i=0; i<1000; ++i )
+    {
+        responses.push_back(restEngine.handleAsync(pool, increment));
+        responses.push_back(restEngine.handleAsync(pool, incrementLater));
+        responses.push_back(restEngine.handleAsync(pool, quarter));
+        responses.push_back(restEngine.handleAsync(pool, invalidQuarter));
+    }
+    int maxCount = 0;
+    bool quartered = true;
+    for ( size_t i=0; i<responses.size(); i+=4 )
+    {
+        maxCount = std::max({maxCount, Json::read<int>(responses[i].get().body), Json::read<int>(responses[i+1].get().body)});
+        quartered = quartered && responses[i+2].get().body == "5" && responses[i+3].get().status == 400;
+    }
+    std::cout << (maxCount == 2001 && quartered ? "  ok     " : "  FAILED ") << responses.size() << " concurrent requests on "
+        << pool.size() << " threads" << std::endl;
 
     decltype(restEngine)::Debug();
 }
 
+// Measures requests/sec & p99 latency of in-process requests handled on thread pools of increasing size, a fixed number of requests per
+// thread are kept in flight (each response sends the next request)
+void restBenchmark()
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr size_t totalRequests = 200000;
+    constexpr size_t inFlightPerThread = 4;
+    const Rest::Request request {Http::Method::GET, "/my/other/path/add/2/3"};
+
+    size_t maxThreads = std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+    std::vector<size_t> threadCounts {};
+    for ( size_t threads = 1; threads < maxThreads; threads *= 2 )
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    std::cout << "threads  requests/s  p99 latency (us)" << std::endl;
+    for ( size_t threads : threadCounts )
+    {
+        std::vector<Clock::time_point> sent(totalRequests);
+        std::vector<Clock::duration> latencies(totalRequests);
+        std::atomic<size_t> next = 0;
+        std::atomic<size_t> completed = 0;
+        std::promise<void> finished {};
+        auto done = finished.get_future();
+        Rest::ThreadPool pool(threads);
+
+        std::function<void(size_t)> send = [&](size_t i) {
+            sent[i] = Clock::now();
+            restEngine.handleAsync(pool, request, [&, i](Rest::Response) {
+                latencies[i] = Clock::now() - sent[i];
+                if ( size_t n = next++; n < totalRequests )
+                    send(n);
+                if ( ++completed == totalRequests )
+                    finished.set_value();
+            });
+        };
+
+        auto start = Clock::now();
+        size_t inFlight = std::min(threads*inFlightPerThread, totalRequests);
+        next = inFlight;
+        for ( size_t i=0; i<inFlight; ++i )
+            send(i);
+
+        done.wait();
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        auto p99 = latencies.begin() + std::ptrdiff_t(totalRequests*99/100);
+        std::nth_element(latencies.begin(), p99, latencies.end());
+        std::cout << std::setw(7) << threads << std::setw(12) << size_t(double(totalRequests)/seconds)
+            << std::setw(18) << std::chrono::duration_cast<std::chrono::microseconds>(*p99).count() << std::endl;
+    }
+}
+
 }
@@ -4,6 +4,7 @@
 // Experimental
 namespace experimental {
     void rest();
+    void restBenchmark();
     void dataHistory();
 }
 
@@ -16,6 +17,7 @@ void openMenu()
         .item(
             Menu("Experimental", "Select an experiment: ")
             .item("Rest experiment", &experimental::rest)
+            .item("Rest benchmark", &experimental::restBenchmark)
             .item("Data history experiment", &experimental::dataHistory)
         ).item(
             Menu("Legacy examples", "Select an example: ")
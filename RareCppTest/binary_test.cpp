@@ -0,0 +1,251 @@
+#include <rarecpp/binary.h>
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <stack>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace BinaryTest
+{
+    enum class Color : uint8_t { Red, Green, Blue };
+
+    struct Point
+    {
+        int x = 0;
+        int y = 0;
+
+        REFLECT(Point, x, y)
+    };
+
+    struct Base
+    {
+        std::string baseName;
+
+        REFLECT(Base, baseName)
+    };
+
+    NOTE(Record, RareTs::Super<Base>)
+    struct Record : Base
+    {
+        bool flag = false;
+        int32_t integer = 0;
+        double decimal = 0.0;
+        Color color = Color::Red;
+        std::string str;
+        std::vector<int> ints;
+        std::vector<bool> bools;
+        int grid[2][3] {};
+        std::array<Point, 2> corners {};
+        std::vector<Point> points;
+        std::list<std::string> strs;
+        std::map<std::string, int> map;
+        std::set<int> set;
+        std::stack<int> stack;
+        std::optional<Point> optional;
+        std::optional<int> emptyOptional;
+        std::unique_ptr<Point> unique;
+        std::shared_ptr<int> nullShared;
+        std::pair<int, std::string> pair;
+        std::tuple<int, bool, std::string> tuple;
+
+        NOTE(ignored, Json::Ignore)
+        int ignored = 0;
+
+        static int staticValue;
+
+        REFLECT_NOTED(Record, flag, integer, decimal, color, str, ints, bools, grid, corners, points, strs, map, set, stack,
+            optional, emptyOptional, unique, nullShared, pair, tuple, ignored, staticValue)
+    };
+
+    int Record::staticValue = 0;
+
+    struct Customized
+    {
+        int value = 0;
+        int zigzagged = 0;
+
+        REFLECT(Customized, value, zigzagged)
+    };
+}
+
+template <>
+struct Binary::Output::Customize<BinaryTest::Customized, int, RareTs::IndexOf<BinaryTest::Customized>::zigzagged>
+{
+    static bool as(std::string & output, const BinaryTest::Customized &, const int & value)
+    { // Zigzag encoding keeps small negative values small
+        Binary::Put::varint(output, static_cast<size_t>((static_cast<uint32_t>(value) << 1) ^ (value < 0 ? ~uint32_t(0) : uint32_t(0))));
+        return true;
+    }
+};
+
+template <>
+struct Binary::Input::Customize<BinaryTest::Customized, int, RareTs::IndexOf<BinaryTest::Customized>::zigzagged>
+{
+    static bool as(Binary::Source & input, BinaryTest::Customized &, int & value)
+    {
+        size_t encoded = input.varint();
+        value = static_cast<int>(static_cast<uint32_t>(encoded >> 1) ^ (encoded & 1 ? ~uint32_t(0) : uint32_t(0)));
+        return true;
+    }
+};
+
+using namespace BinaryTest;
+
+TEST(BinaryTest, Primitives)
+{
+    EXPECT_EQ(std::string(1, '\1'), Binary::write(true));
+    EXPECT_EQ(sizeof(int32_t), Binary::write(int32_t(1234)).size());
+    EXPECT_EQ(1234, Binary::read<int32_t>(Binary::write(int32_t(1234))));
+    EXPECT_EQ(-1.5, Binary::read<double>(Binary::write(-1.5)));
+    EXPECT_EQ(Color::Blue, Binary::read<Color>(Binary::write(Color::Blue)));
+}
+
+TEST(BinaryTest, Varints)
+{
+    std::string output {};
+    Binary::Put::varint(output, 0x7F);
+    EXPECT_EQ(1, output.size());
+    Binary::Put::varint(output, 0x80);
+    EXPECT_EQ(3, output.size());
+    Binary::Put::varint(output, std::numeric_limits<size_t>::max());
+
+    Binary::Source source(output);
+    EXPECT_EQ(0x7F, source.varint());
+    EXPECT_EQ(0x80, source.varint());
+    EXPECT_EQ(std::numeric_limits<size_t>::max(), source.varint());
+    EXPECT_EQ(0, source.remaining());
+}
+
+TEST(BinaryTest, BlockCopiedContainers)
+{
+    std::vector<int> ints { 1, 2, 3, 4, 5 };
+    std::string output = Binary::write(ints);
+    EXPECT_EQ(1 + ints.size()*sizeof(int), output.size());
+    EXPECT_EQ(ints, Binary::read<std::vector<int>>(output));
+
+    std::string str = "some string";
+    output = Binary::write(str);
+    EXPECT_EQ(1 + str.size(), output.size());
+    EXPECT_EQ(str, Binary::read<std::string>(output));
+
+    int grid[2][3] { { 1, 2, 3 }, { 4, 5, 6 } };
+    output = Binary::write(grid);
+    EXPECT_EQ(sizeof(grid), output.size());
+    int gridCopy[2][3] {};
+    Binary::read(output, gridCopy);
+    EXPECT_EQ(0, std::memcmp(grid, gridCopy, sizeof(grid)));
+}
+
+TEST(BinaryTest, RoundTripObject)
+{
+    Record record {};
+    record.baseName = "base";
+    record.flag = true;
+    record.integer = -42;
+    record.decimal = 3.25;
+    record.color = Color::Green;
+    record.str = "str";
+    record.ints = { 1, 2, 3 };
+    record.bools = { true, false, true };
+    record.grid[1][2] = 7;
+    record.corners = { Point{1, 2}, Point{3, 4} };
+    record.points = { Point{5, 6} };
+    record.strs = { "a", "bc" };
+    record.map = { { "one", 1 }, { "two", 2 } };
+    record.set = { 3, 1, 2 };
+    record.stack.push(10);
+    record.stack.push(20);
+    record.optional = Point{7, 8};
+    record.unique = std::make_unique<Point>(Point{9, 10});
+    record.pair = { 11, "pair" };
+    record.tuple = { 12, true, "tuple" };
+    record.ignored = 99;
+    Record::staticValue = 55;
+
+    std::string output = Binary::write(record);
+    Record::staticValue = 0;
+
+    Record read {};
+    read.nullShared = std::make_shared<int>(1);
+    Binary::read(output, read);
+
+    EXPECT_EQ("base", read.baseName);
+    EXPECT_TRUE(read.flag);
+    EXPECT_EQ(-42, read.integer);
+    EXPECT_EQ(3.25, read.decimal);
+    EXPECT_EQ(Color::Green, read.color);
+    EXPECT_EQ("str", read.str);
+    EXPECT_EQ(record.ints, read.ints);
+    EXPECT_EQ(record.bools, read.bools);
+    EXPECT_EQ(7, read.grid[1][2]);
+    EXPECT_EQ(3, read.corners[1].x);
+    EXPECT_EQ(4, read.corners[1].y);
+    ASSERT_EQ(1, read.points.size());
+    EXPECT_EQ(6, read.points[0].y);
+    EXPECT_EQ(record.strs, read.strs);
+    EXPECT_EQ(record.map, read.map);
+    EXPECT_EQ(record.set, read.set);
+    ASSERT_EQ(2, read.stack.size());
+    EXPECT_EQ(20, read.stack.top());
+    ASSERT_TRUE(read.optional.has_value());
+    EXPECT_EQ(8, read.optional->y);
+    EXPECT_FALSE(read.emptyOptional.has_value());
+    ASSERT_NE(nullptr, read.unique);
+    EXPECT_EQ(10, read.unique->y);
+    EXPECT_EQ(nullptr, read.nullShared);
+    EXPECT_EQ(record.pair, read.pair);
+    EXPECT_EQ(record.tuple, read.tuple);
+    EXPECT_EQ(0, read.ignored);
+    EXPECT_EQ(0, Record::staticValue);
+}
+
+TEST(BinaryTest, Customize)
+{
+    Customized customized { 3, -1001 };
+    std::string output = Binary::write(customized);
+    EXPECT_EQ(sizeof(int) + 2, output.size()); // 2001 fits in a two-byte varint
+
+    Customized read = Binary::read<Customized>(output);
+    EXPECT_EQ(3, read.value);
+    EXPECT_EQ(-1001, read.zigzagged);
+
+    customized.zigzagged = 1001;
+    EXPECT_EQ(1001, Binary::read<Customized>(Binary::write(customized)).zigzagged);
+}
+
+TEST(BinaryTest, TruncatedInput)
+{
+    Point point { 1, 2 };
+    std::string output = Binary::write(point);
+    output.pop_back();
+    EXPECT_THROW(Binary::read<Point>(output), Binary::UnexpectedInputEnd);
+
+    std::string str = Binary::write(std::string("abc"));
+    str.pop_back();
+    EXPECT_THROW(Binary::read<std::string>(str), Binary::UnexpectedInputEnd);
+}
+
+TEST(BinaryTest, VarintOverflow)
+{
+    std::string max {};
+    Binary::Put::varint(max, std::numeric_limits<size_t>::max());
+    EXPECT_EQ(Binary::maxVarintSize, max.size());
+    Binary::Source source(max);
+    EXPECT_EQ(std::numeric_limits<size_t>::max(), source.varint());
+
+    std::string tooLarge(Binary::maxVarintSize, char(0xFF)); // Continues past the last byte a size_t can hold
+    tooLarge.push_back(char(0x01));
+    EXPECT_THROW(Binary::read<std::string>(tooLarge), Binary::VarintOverflow);
+
+    max.back() = char(max.back() | 0x02); // Sets a bit beyond those of a size_t in the final byte
+    EXPECT_THROW(Binary::read<std::string>(max), Binary::VarintOverflow);
+}
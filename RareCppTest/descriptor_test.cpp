@@ -0,0 +1,140 @@
+#include <rarecpp/descriptor.h>
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace DescriptorTest
+{
+    struct Point
+    {
+        int x = 0;
+        int y = 0;
+
+        REFLECT(Point, x, y)
+    };
+
+    struct Shape
+    {
+        std::string name;
+        Point origin;
+        std::vector<Point> points;
+        NOTE(layer, Json::Name{"z"})
+        std::optional<int> layer;
+        NOTE(cache, Json::Ignore)
+        int cache = 0;
+
+        static int staticValue;
+        int method() { return 0; }
+
+        REFLECT(Shape, name, origin, points, layer, cache, staticValue, method)
+    };
+
+    int Shape::staticValue = 0;
+
+    struct Derived : Point
+    {
+        int z = 0;
+
+        REFLECT(Derived, z)
+    };
+
+    struct Unconstructible
+    {
+        Unconstructible(int value) : value(value) {}
+        int value;
+
+        REFLECT(Unconstructible, value)
+    };
+}
+
+using namespace DescriptorTest;
+
+TEST(DescriptorTest, Describe)
+{
+    constexpr const RareTs::type_descriptor & shape = RareTs::describe<Shape>();
+    EXPECT_TRUE(shape.composite);
+    EXPECT_EQ(sizeof(Shape), shape.size);
+    EXPECT_EQ(alignof(Shape), shape.alignment);
+    ASSERT_EQ(size_t(5), shape.members.size());
+
+    EXPECT_EQ("origin", shape.members[1].name);
+    EXPECT_EQ(size_t(1), shape.members[1].index);
+    EXPECT_EQ(offsetof(Shape, origin), shape.members[1].offset);
+    EXPECT_EQ(sizeof(Point), shape.members[1].size);
+    EXPECT_EQ(&RareTs::describe<Point>(), shape.members[1].type);
+    EXPECT_TRUE(shape.members[4].jsonIgnored);
+    EXPECT_EQ(&shape.members[3], shape.member("layer"));
+    EXPECT_EQ("z", shape.members[3].jsonName);
+    EXPECT_EQ(&shape.members[3], shape.jsonMember("z"));
+    EXPECT_EQ(nullptr, shape.jsonMember("layer"));
+    EXPECT_EQ(nullptr, shape.member("staticValue"));
+
+    static_assert(RareTs::describe<Point>().members[1].offset == offsetof(Point, y));
+    EXPECT_EQ(&RareTs::describe<int>(), RareTs::describe<Point>().members[0].type);
+    EXPECT_FALSE(RareTs::describe<int>().composite);
+    EXPECT_FALSE(RareTs::describe<Derived>().composite); // Supers are not described
+    EXPECT_EQ(nullptr, RareTs::describe<Unconstructible>().construct);
+    EXPECT_EQ(nullptr, shape.writeJson);
+    EXPECT_NE(nullptr, RareTs::describe<std::vector<Point>>().writeJson);
+}
+
+TEST(DescriptorTest, Lifetime)
+{
+    const RareTs::type_descriptor & shape = RareTs::describe<Shape>();
+    alignas(Shape) unsigned char storage[sizeof(Shape)];
+    shape.construct(storage);
+    Shape source {"square", {1, 2}, {{3, 4}}, 5, 6};
+    shape.copy(storage, &source);
+    Shape* copy = std::launder(reinterpret_cast<Shape*>(storage));
+    EXPECT_EQ("square", copy->name);
+    EXPECT_EQ(size_t(1), copy->points.size());
+    EXPECT_TRUE(RareTs::equal(shape, copy, &source));
+    shape.destroy(storage);
+}
+
+TEST(DescriptorTest, Json)
+{
+    const RareTs::type_descriptor & shape = RareTs::describe<Shape>();
+    Shape source {"square", {1, 2}, {{3, 4}, {5, 6}}, 7, 8};
+    std::string json {};
+    RareTs::writeJson(shape, &source, json);
+    EXPECT_EQ(Json::write(source), json);
+    EXPECT_NE(std::string::npos, json.find("\"z\":7"));
+
+    Shape read {};
+    RareTs::readJson(shape, " { \"unknown\": [{\"a\": \"}\"}], \"cache\": 9, " + json.substr(1), &read);
+    EXPECT_EQ("square", read.name);
+    EXPECT_EQ(2, read.origin.y);
+    ASSERT_EQ(size_t(2), read.points.size());
+    EXPECT_EQ(6, read.points[1].y);
+    EXPECT_EQ(std::optional<int>(7), read.layer);
+    EXPECT_EQ(0, read.cache);
+
+    RareTs::readJson(shape, "{\"layer\":null}", &read); // Fields are read by their Json names
+    EXPECT_EQ(std::optional<int>(7), read.layer);
+    RareTs::readJson(shape, "{\"z\":null}", &read);
+    EXPECT_FALSE(read.layer.has_value());
+    EXPECT_THROW(RareTs::readJson(shape, "{\"name\":", &read), Json::Exception);
+    EXPECT_THROW(RareTs::readJson(shape, "{\"unknown\": ], \"name\": \"a\"}", &read), Json::Exception);
+}
+
+TEST(DescriptorTest, Differences)
+{
+    const RareTs::type_descriptor & shape = RareTs::describe<Shape>();
+    Shape before {"square", {1, 2}, {{3, 4}}, std::nullopt, 0};
+    Shape after = before;
+    EXPECT_TRUE(RareTs::differences(shape, &before, &after).empty());
+
+    after.origin.y = 3;
+    after.layer = 1;
+    after.cache = 1;
+    std::vector<std::string> expected { "/origin/y", "/layer", "/cache" };
+    EXPECT_EQ(expected, RareTs::differences(shape, &before, &after));
+    EXPECT_FALSE(RareTs::equal(shape, &before, &after));
+
+    int l = 1, r = 2;
+    EXPECT_EQ(std::vector<std::string>{""}, RareTs::differences(RareTs::describe<int>(), &l, &r));
+}
@@ -0,0 +1,139 @@
+#include <rarecpp/diff.h>
+#include <gtest/gtest.h>
+#include <array>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace DiffTest
+{
+    struct Point
+    {
+        int x = 0;
+        int y = 0;
+
+        REFLECT(Point, x, y)
+    };
+
+    struct Base
+    {
+        std::string baseName;
+
+        REFLECT(Base, baseName)
+    };
+
+    NOTE(Scene, RareTs::Super<Base>)
+    struct Scene : Base
+    {
+        int id = 0;
+        std::string name;
+        std::vector<Point> points;
+        std::array<int, 3> triple {};
+        std::optional<Point> focus;
+        std::unique_ptr<Point> origin;
+        std::map<std::string, int> counts;
+
+        NOTE(cache, Json::Ignore)
+        int cache = 0;
+
+        REFLECT_NOTED(Scene, id, name, points, triple, focus, origin, counts, cache)
+    };
+
+    Scene makeScene()
+    {
+        Scene scene {};
+        scene.baseName = "base";
+        scene.id = 1;
+        scene.name = "scene";
+        scene.points = { Point{1, 2}, Point{3, 4} };
+        scene.triple = { 1, 2, 3 };
+        scene.focus = Point{5, 6};
+        scene.origin = std::make_unique<Point>(Point{7, 8});
+        scene.counts = { { "a", 1 } };
+        return scene;
+    }
+}
+
+using namespace DiffTest;
+
+TEST(DiffTest, EqualObjects)
+{
+    Scene before = makeScene();
+    Scene after = makeScene();
+    after.cache = 5; // Ignored members are not diffed
+    EXPECT_TRUE(RareTs::diff(before, after).empty());
+}
+
+TEST(DiffTest, DiffAndApply)
+{
+    Scene before = makeScene();
+    Scene after = makeScene();
+    after.baseName = "changed base";
+    after.points[1].y = 40;
+    after.triple[0] = 10;
+    after.focus->x = 50;
+    after.origin->y = 80;
+    after.counts["b"] = 2;
+
+    RareTs::Patch patch = RareTs::diff(before, after);
+    ASSERT_EQ(size_t(6), patch.size());
+    EXPECT_STREQ("/points/1/y", patch.changes[0].path.c_str());
+    EXPECT_STREQ("40", patch.changes[0].value.c_str());
+    EXPECT_STREQ("/triple/0", patch.changes[1].path.c_str());
+    EXPECT_STREQ("/focus/x", patch.changes[2].path.c_str());
+    EXPECT_STREQ("/origin/y", patch.changes[3].path.c_str());
+    EXPECT_STREQ("/counts", patch.changes[4].path.c_str());
+    EXPECT_STREQ("/__DiffTest::Base/baseName", patch.changes[5].path.c_str());
+
+    RareTs::apply(before, patch);
+    EXPECT_TRUE(RareTs::diff(before, after).empty());
+    EXPECT_EQ(40, before.points[1].y);
+    EXPECT_EQ(2, before.counts["b"]);
+    EXPECT_STREQ("changed base", before.baseName.c_str());
+}
+
+TEST(DiffTest, WholeReplacements)
+{
+    Scene before = makeScene();
+    Scene after = makeScene();
+    after.points.push_back(Point{9, 9});
+    after.focus = std::nullopt;
+    after.name = "renamed";
+
+    RareTs::Patch patch = RareTs::diff(before, after);
+    ASSERT_EQ(size_t(3), patch.size());
+    EXPECT_STREQ("/name", patch.changes[0].path.c_str());
+    EXPECT_STREQ("\"renamed\"", patch.changes[0].value.c_str());
+    EXPECT_STREQ("/points", patch.changes[1].path.c_str());
+    EXPECT_STREQ("/focus", patch.changes[2].path.c_str());
+    EXPECT_STREQ("null", patch.changes[2].value.c_str());
+
+    RareTs::apply(before, patch);
+    EXPECT_TRUE(RareTs::diff(before, after).empty());
+    EXPECT_EQ(size_t(3), before.points.size());
+    EXPECT_FALSE(before.focus.has_value());
+}
+
+TEST(DiffTest, PatchJson)
+{
+    Scene before = makeScene();
+    Scene after = makeScene();
+    after.id = 2;
+    after.points[0].x = -1;
+
+    std::string json = Json::write(RareTs::diff(before, after));
+    EXPECT_STREQ("{\"changes\":[{\"path\":\"/id\",\"value\":\"2\"},{\"path\":\"/points/0/x\",\"value\":\"-1\"}]}", json.c_str());
+
+    RareTs::Patch patch = Json::read<RareTs::Patch>(json);
+    RareTs::apply(before, patch);
+    EXPECT_EQ(2, before.id);
+    EXPECT_EQ(-1, before.points[0].x);
+
+    RareTs::Patch invalid {};
+    invalid.changes.push_back(RareTs::Change{"/points/5/x", "1"});
+    EXPECT_THROW(RareTs::apply(before, invalid), RareTs::InvalidPatchPath);
+    invalid.changes[0].path = "/missing";
+    EXPECT_THROW(RareTs::apply(before, invalid), RareTs::InvalidPatchPath);
+}
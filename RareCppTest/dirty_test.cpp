@@ -0,0 +1,112 @@
+#include <rarecpp/dirty.h>
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace DirtyTest
+{
+    struct Point
+    {
+        int x = 0;
+        std::vector<int> y {};
+
+        REFLECT(Point, x, y)
+    };
+
+    struct Player
+    {
+        int hp = 100;
+        std::string name = "player";
+        Point pos {};
+        NOTE(secret, Json::Ignore)
+        int secret = 0;
+        NOTE(score, Json::Name{"pts"})
+        int score = 0;
+
+        static int staticValue;
+        int method() { return 0; }
+
+        REFLECT(Player, hp, name, pos, secret, score, staticValue, method)
+    };
+
+    int Player::staticValue = 0;
+}
+
+using namespace DirtyTest;
+
+TEST(DirtyTest, Flags)
+{
+    EXPECT_EQ(size_t(7), RareTs::dirty_tracked<Player>::flags_type{}.size()); // hp, name, pos, pos.x, pos.y, secret, score
+    EXPECT_EQ(size_t(2), RareTs::DirtyTracking::detail::memberFlags<Player>[2]);
+    EXPECT_EQ(RareTs::DirtyTracking::detail::NoFlag, RareTs::DirtyTracking::detail::memberFlags<Player>[5]);
+    EXPECT_EQ(size_t(2), RareTs::DirtyTracking::detail::parentFlags<Player>[3]);
+    EXPECT_EQ(RareTs::DirtyTracking::detail::NoFlag, RareTs::DirtyTracking::detail::parentFlags<Player>[2]);
+}
+
+TEST(DirtyTest, TrackAssignments)
+{
+    Player player {};
+    RareTs::dirty_tracked tracked(player);
+    EXPECT_FALSE(tracked.dirty());
+
+    tracked.hp = 100; // Equal values aren't marked
+    EXPECT_FALSE(tracked.dirty());
+
+    tracked.hp = 90;
+    EXPECT_EQ(90, player.hp);
+    EXPECT_TRUE(tracked.hp.dirty());
+    EXPECT_FALSE(tracked.name.dirty());
+    int hp = tracked.hp;
+    EXPECT_EQ(90, hp);
+    EXPECT_EQ(size_t(6), tracked.name->size());
+
+    tracked.pos.x = 3;
+    EXPECT_EQ(3, player.pos.x);
+    EXPECT_TRUE(tracked.pos.x.dirty());
+    EXPECT_TRUE(tracked.pos.dirty());
+    EXPECT_FALSE(tracked.pos.y.dirty());
+
+    tracked.pos.y.edit().push_back(1);
+    EXPECT_EQ(size_t(1), player.pos.y.size());
+    EXPECT_TRUE(tracked.pos.y.dirty());
+    EXPECT_EQ(size_t(4), tracked.dirtyFlags().count());
+
+    tracked.clearDirty();
+    EXPECT_FALSE(tracked.dirty());
+    tracked.pos.y.edit();
+    EXPECT_TRUE(tracked.pos.dirty()); // Containing members are re-marked after clearing
+
+    tracked.clearDirty();
+    tracked.pos = Point{5, {}};
+    EXPECT_EQ(5, player.pos.x);
+    EXPECT_TRUE(tracked.pos.dirty());
+    EXPECT_TRUE(tracked.pos.x.dirty());
+    EXPECT_TRUE(tracked.pos.y.dirty());
+    EXPECT_FALSE(tracked.hp.dirty());
+}
+
+TEST(DirtyTest, OutDirty)
+{
+    Player player {};
+    RareTs::dirty_tracked tracked(player);
+    EXPECT_EQ("{}", Json::writeDirty(tracked));
+
+    tracked.hp = 90;
+    tracked.pos.y.edit().push_back(1);
+    tracked.secret = 1;
+    tracked.score = 2;
+    EXPECT_EQ("{\"hp\":90,\"pos\":{\"y\":[1]},\"pts\":2}", Json::writeDirty(tracked));
+
+    std::stringstream ss;
+    ss << Json::outDirty(tracked);
+    EXPECT_EQ(Json::writeDirty(tracked), ss.str());
+
+    tracked.clearDirty();
+    tracked.name = "renamed";
+    EXPECT_EQ("{\"name\":\"renamed\"}", Json::writeDirty(tracked));
+
+    tracked.markAllDirty();
+    EXPECT_EQ(Json::write(player), Json::writeDirty(tracked));
+}
@@ -2228,6 +2228,52 @@ namespace editor_cumulative
         EXPECT_EQ(expected, obj->ints);
     }
 
+    struct Track_sort_by_data
+    {
+        struct Item
+        {
+            int group = 0;
+            int value = 0;
+
+            REFLECT(Item, group, value)
+        };
+
+        std::vector<Item> items;
+
+        REFLECT(Track_sort_by_data, items)
+    };
+
+    struct Track_sort_by : nf::tracked<Track_sort_by_data, Track_sort_by>
+    {
+        Track_sort_by() : tracked{this} {}
+    };
+
+    TEST(op_undo_redo, sort_by)
+    {
+        Track_sort_by obj {};
+        using Item = Track_sort_by_data::Item;
+        const auto values = std::vector<Item>{{2, 1}, {1, 5}, {2, 0}, {1, 3}};
+        obj()->items = values;
+        obj()->items.sort_by<&Item::group>();
+        auto values_of = [&]() {
+            std::vector<int> result {};
+            for ( const auto & item : obj->items )
+                result.push_back(item.value);
+            return result;
+        };
+        EXPECT_EQ(std::vector({5, 3, 1, 0}), values_of());
+        obj()->items.sort_by_desc<&Item::group, &Item::value>();
+        EXPECT_EQ(std::vector({1, 0, 5, 3}), values_of());
+
+        obj.undo_action();
+        EXPECT_EQ(std::vector({5, 3, 1, 0}), values_of());
+        obj.undo_action();
+        EXPECT_EQ(std::vector({1, 5, 0, 3}), values_of());
+        obj.redo_action();
+        obj.redo_action();
+        EXPECT_EQ(std::vector({1, 0, 5, 3}), values_of());
+    }
+
     TEST(op_undo_redo, swap)
     {
         Track_do_op obj {};
@@ -1025,6 +1025,15 @@ TEST(RareTsTest, IsAssignable)
     isAssignable = RareTs::is_assignable_v<R4, L4>;
     EXPECT_FALSE(isAssignable);
 
+    isAssignable = RareTs::is_move_assignable_v<L2, R2>;
+    EXPECT_TRUE(isAssignable); // Move-assignment operator should signal move-assignability
+    isAssignable = RareTs::is_move_assignable_v<L4, R4>;
+    EXPECT_TRUE(isAssignable); // Move-constructor should signal move-assignability
+    isAssignable = RareTs::is_move_assignable_v<L1, R1>;
+    EXPECT_TRUE(isAssignable); // Rvalues bind to const references
+    isAssignable = RareTs::is_move_assignable_v<R2, L2>;
+    EXPECT_FALSE(isAssignable);
+
     struct L5
     {
         int a;
@@ -0,0 +1,183 @@
+#include <rarecpp/hash.h>
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace HashTest
+{
+    struct Packed
+    {
+        std::int32_t a = 0;
+        std::int32_t b = 0;
+        std::int64_t c = 0;
+
+        REFLECT(Packed, a, b, c)
+    };
+
+    struct Padded
+    {
+        char a = 0;
+        std::int64_t b = 0;
+
+        REFLECT(Padded, a, b)
+    };
+
+    struct Key
+    {
+        std::string name;
+        double weight = 0.0;
+        std::vector<Packed> packed;
+        std::optional<int> optional;
+        std::map<std::string, int> map;
+        std::unordered_set<int> set;
+        std::pair<int, std::string> pair;
+        std::tuple<int, bool> tuple;
+        int grid[2][2] {};
+
+        NOTE(cache, RareTs::HashIgnore)
+        int cache = 0;
+
+        REFLECT(Key, name, weight, packed, optional, map, set, pair, tuple, grid, cache)
+    };
+
+    struct PartiallyReflected
+    {
+        std::int32_t a = 0;
+        std::int32_t b = 0;
+
+        REFLECT(PartiallyReflected, a)
+    };
+
+    struct WithIgnored
+    {
+        std::int32_t a = 0;
+
+        NOTE(b, RareTs::HashIgnore)
+        std::int32_t b = 0;
+
+        REFLECT(WithIgnored, a, b)
+    };
+
+    struct Base
+    {
+        int baseValue = 0;
+
+        REFLECT(Base, baseValue)
+    };
+
+    NOTE(Derived, RareTs::Super<Base>)
+    struct Derived : Base
+    {
+        int derivedValue = 0;
+
+        REFLECT_NOTED(Derived, derivedValue)
+    };
+
+    struct Specialized
+    {
+        int value = 0;
+
+        bool operator==(const Specialized & other) const { return value == other.value; }
+
+        REFLECT(Specialized, value)
+    };
+}
+
+template <> struct std::hash<HashTest::Specialized> : RareTs::hasher<HashTest::Specialized> {};
+
+using namespace HashTest;
+
+TEST(HashTest, BulkHashable)
+{
+    EXPECT_TRUE(RareTs::isBulkHashable<Packed>());
+    EXPECT_TRUE(RareTs::isBulkHashable<Packed[3]>());
+    EXPECT_FALSE(RareTs::isBulkHashable<Padded>());
+    EXPECT_FALSE(RareTs::isBulkHashable<WithIgnored>());
+    EXPECT_FALSE(RareTs::isBulkHashable<PartiallyReflected>());
+    EXPECT_FALSE(RareTs::isBulkHashable<Derived>());
+    EXPECT_FALSE(RareTs::isBulkHashable<double>());
+    EXPECT_FALSE(RareTs::isBulkHashable<Key>());
+
+    Packed packed { 1, 2, 3 };
+    EXPECT_EQ(RareTs::hashBytes(&packed, sizeof(packed)), RareTs::hash(packed));
+
+    std::vector<Packed> packedVec { packed, Packed{4, 5, 6} };
+    EXPECT_EQ(RareTs::hashBytes(packedVec.data(), packedVec.size()*sizeof(Packed)), RareTs::hash(packedVec));
+
+    PartiallyReflected partial { 1, 2 };
+    PartiallyReflected otherUnreflected { 1, 3 }; // Equal by reflection
+    EXPECT_EQ(RareTs::hash(partial), RareTs::hash(otherUnreflected));
+}
+
+TEST(HashTest, Memberwise)
+{
+    Padded padded {};
+    padded.a = 'a';
+    padded.b = 5;
+    Padded samePadded {};
+    std::memset(static_cast<void*>(&samePadded), 0xFF, sizeof(samePadded)); // Padding bytes differ but do not contribute to the hash
+    samePadded.a = 'a';
+    samePadded.b = 5;
+    EXPECT_EQ(RareTs::hash(padded), RareTs::hash(samePadded));
+
+    WithIgnored ignored { 1, 2 };
+    WithIgnored otherIgnored { 1, 3 };
+    EXPECT_EQ(RareTs::hash(ignored), RareTs::hash(otherIgnored));
+    otherIgnored.a = 2;
+    EXPECT_NE(RareTs::hash(ignored), RareTs::hash(otherIgnored));
+
+    Derived derived {};
+    derived.baseValue = 1;
+    Derived otherDerived {};
+    otherDerived.baseValue = 2;
+    EXPECT_NE(RareTs::hash(derived), RareTs::hash(otherDerived));
+
+    Key key {};
+    key.name = "key";
+    key.weight = 1.5;
+    key.packed = { Packed{1, 2, 3} };
+    key.optional = 4;
+    key.map = { { "a", 1 }, { "b", 2 } };
+    key.set = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    key.pair = { 1, "pair" };
+    key.tuple = { 2, true };
+    key.grid[1][1] = 3;
+    key.cache = 100;
+
+    Key same = key;
+    same.cache = 200;
+    same.set.clear();
+    for ( int i=8; i>0; --i ) // Different insertion order may iterate differently, but unordered containers hash order-independently
+        same.set.insert(i);
+
+    EXPECT_EQ(RareTs::hash(key), RareTs::hash(same));
+    same.grid[1][1] = 4;
+    EXPECT_NE(RareTs::hash(key), RareTs::hash(same));
+    same = key;
+    same.optional = std::nullopt;
+    EXPECT_NE(RareTs::hash(key), RareTs::hash(same));
+}
+
+TEST(HashTest, Hasher)
+{
+    std::unordered_map<Packed, int, RareTs::hasher<Packed>, bool(*)(const Packed &, const Packed &)> map(0, RareTs::hasher<Packed>{},
+        [](const Packed & l, const Packed & r) { return l.a == r.a && l.b == r.b && l.c == r.c; });
+    map[Packed{1, 2, 3}] = 1;
+    map[Packed{1, 2, 3}] += 1;
+    map[Packed{3, 2, 1}] = 5;
+    EXPECT_EQ(size_t(2), map.size());
+    EXPECT_EQ(2, (map[Packed{1, 2, 3}]));
+
+    std::unordered_set<Specialized> set { Specialized{1}, Specialized{2}, Specialized{1} };
+    EXPECT_EQ(size_t(2), set.size());
+    EXPECT_EQ(std::hash<Specialized>{}(Specialized{1}), RareTs::hash(Specialized{1}));
+}
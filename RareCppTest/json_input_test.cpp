@@ -1,7 +1,13 @@
 #ifdef GET_RUNJSONINPUTTESTSRC_INCLUDES
 #include "json_input_test.h"
+#include <rarecpp/mapped_file.h>
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
 #include <optional>
 #include <regex>
 #endif
@@ -1242,13 +1248,13 @@ TEST_HEADER(JsonInputRead, GenericArray)
     assigner = Json::Read::genericArray<true, false>(numberArray, Json::defaultContext, c);
     EXPECT_EQ(Json::Value::Type::NumberArray, assigner->get()->type());
     EXPECT_EQ(size_t(7), assigner->get()->arraySize());
-    EXPECT_STREQ("12", assigner->get()->numberArray()[0].c_str());
-    EXPECT_STREQ("13", assigner->get()->numberArray()[1].c_str());
-    EXPECT_STREQ("13.5", assigner->get()->numberArray()[2].c_str());
-    EXPECT_STREQ("15", assigner->get()->numberArray()[3].c_str());
-    EXPECT_STREQ("-12.322", assigner->get()->numberArray()[4].c_str());
-    EXPECT_STREQ("-5", assigner->get()->numberArray()[5].c_str());
-    EXPECT_STREQ("6", assigner->get()->numberArray()[6].c_str());
+    EXPECT_STREQ("12", assigner->get()->numberArray()[0].str().c_str());
+    EXPECT_STREQ("13", assigner->get()->numberArray()[1].str().c_str());
+    EXPECT_STREQ("13.5", assigner->get()->numberArray()[2].str().c_str());
+    EXPECT_STREQ("15", assigner->get()->numberArray()[3].str().c_str());
+    EXPECT_STREQ("-12.322", assigner->get()->numberArray()[4].str().c_str());
+    EXPECT_STREQ("-5", assigner->get()->numberArray()[5].str().c_str());
+    EXPECT_STREQ("6", assigner->get()->numberArray()[6].str().c_str());
 
     assigner = Json::Read::genericArray<true, false>(stringArray, Json::defaultContext, c);
     EXPECT_EQ(Json::Value::Type::StringArray, assigner->get()->type());
@@ -1263,7 +1269,7 @@ TEST_HEADER(JsonInputRead, GenericArray)
     EXPECT_TRUE(assigner->get()->objectArray()[1].find("field")->second->boolean());
     EXPECT_STREQ("hello world", assigner->get()->objectArray()[2].find("str")->second->string().c_str());
     EXPECT_TRUE(assigner->get()->objectArray()[2].find("null")->second == nullptr);
-    EXPECT_STREQ("42", assigner->get()->objectArray()[2].find("num")->second->number().c_str());
+    EXPECT_STREQ("42", assigner->get()->objectArray()[2].find("num")->second->number().str().c_str());
 
     assigner = Json::Read::genericArray<true, false>(mixedArray, Json::defaultContext, c);
     EXPECT_EQ(Json::Value::Type::MixedArray, assigner->get()->type());
@@ -1294,8 +1300,8 @@ TEST_HEADER(JsonInputRead, GenericObject)
 
     assigner = Json::Read::genericObject<false>(basicObject, Json::defaultContext, c);
     EXPECT_TRUE(assigner->get()->object().find("null")->second == nullptr);
-    EXPECT_STREQ("1", assigner->get()->object().find("one")->second->number().c_str());
-    EXPECT_STREQ("2", assigner->get()->object().find("two")->second->number().c_str());
+    EXPECT_STREQ("1", assigner->get()->object().find("one")->second->number().str().c_str());
+    EXPECT_STREQ("2", assigner->get()->object().find("two")->second->number().str().c_str());
 }
 
 struct Keyable
@@ -1986,6 +1992,71 @@ TEST_HEADER(JsonInputRead, Object)
     EXPECT_EQ(6, object.b);
 }
 
+struct OrderedObject
+{
+    int a = 0;
+
+    NOTE(b, Json::Name{"c"})
+    int b = 0;
+
+    NOTE(ignored, Json::Ignore)
+    int ignored = 0;
+
+    std::string d;
+
+    REFLECT(OrderedObject, a, b, ignored, d)
+};
+
+TEST_HEADER(JsonInputRead, ObjectFieldOrder)
+{
+    using Order = Json::FieldOrder<OrderedObject>;
+    EXPECT_EQ(3, Order::total);
+    EXPECT_EQ("a", Order::names[0]);
+    EXPECT_EQ("c", Order::names[1]);
+    EXPECT_EQ("d", Order::names[2]);
+    EXPECT_EQ(3, Order::indexes[2]);
+    EXPECT_EQ(1, Order::positions[1]);
+    EXPECT_EQ(3, Order::positions[2]); // Ignored fields are not ordered
+    EXPECT_EQ(2, Order::positions[3]);
+
+    char c = '\0';
+    OrderedObject inOrder {};
+    std::stringstream inOrderStream("{\"a\":1,\"c\":2,\"d\":\"3\"}");
+    Json::Read::object<NoNote, OrderedObject>(inOrderStream, Json::defaultContext, c, inOrder);
+    EXPECT_EQ(1, inOrder.a);
+    EXPECT_EQ(2, inOrder.b);
+    EXPECT_STREQ("3", inOrder.d.c_str());
+
+    OrderedObject outOfOrder {};
+    std::stringstream outOfOrderStream("{\"d\":\"4\",\"b\":9,\"ignored\":9,\"c\":5,\"a\":6}");
+    Json::Read::object<NoNote, OrderedObject>(outOfOrderStream, Json::defaultContext, c, outOfOrder);
+    EXPECT_EQ(6, outOfOrder.a);
+    EXPECT_EQ(5, outOfOrder.b);
+    EXPECT_EQ(0, outOfOrder.ignored);
+    EXPECT_STREQ("4", outOfOrder.d.c_str());
+
+    OrderedObject missing {};
+    std::stringstream missingStream("{\"unknown\":[1,2],\"d\":\"7\"}");
+    Json::Read::object<NoNote, OrderedObject>(missingStream, Json::defaultContext, c, missing);
+    EXPECT_EQ(0, missing.a);
+    EXPECT_EQ(0, missing.b);
+    EXPECT_STREQ("7", missing.d.c_str());
+
+    OrderedObject skipped {}; // Prediction resumes after a field found by the hashed lookup
+    std::stringstream skippedStream("{\"c\":8,\"d\":\"9\",\"a\":1}");
+    const Json::JsonField* found = nullptr;
+    Json::Read::objectPrefix(skippedStream, c);
+    found = Json::Read::field<NoNote>(skippedStream, Json::defaultContext, c, skipped, Json::Read::fieldName(skippedStream, c));
+    ASSERT_NE(nullptr, found);
+    EXPECT_EQ(1, found->index);
+    skippedStream.str("{\"c\":8,\"d\":\"9\",\"a\":1}");
+    skippedStream.clear();
+    Json::Read::object<NoNote, OrderedObject>(skippedStream, Json::defaultContext, c, skipped);
+    EXPECT_EQ(1, skipped.a);
+    EXPECT_EQ(8, skipped.b);
+    EXPECT_STREQ("9", skipped.d.c_str());
+}
+
 TEST_HEADER(JsonInput, ReflectedObject)
 {
     std::stringstream objectStream("{\"a\":5,\"b\":6}");
@@ -2110,9 +2181,9 @@ TEST_HEADER(JsonInput, In)
     EXPECT_EQ(3, complexStruct.intVector[2]);
     EXPECT_TRUE(complexStruct.fieldCluster.object().find("someUnknown")->second == nullptr);
     EXPECT_EQ(size_t(3), complexStruct.fieldCluster.object().find("someOtherUnknown")->second->arraySize());
-    EXPECT_STREQ("4", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[0].c_str());
-    EXPECT_STREQ("5", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[1].c_str());
-    EXPECT_STREQ("6", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[2].c_str());
+    EXPECT_STREQ("4", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[0].str().c_str());
+    EXPECT_STREQ("5", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[1].str().c_str());
+    EXPECT_STREQ("6", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[2].str().c_str());
 }
 
 TEST_HEADER(JsonInput, ReadRef)
@@ -2159,9 +2230,9 @@ TEST_HEADER(JsonInput, ReadRef)
     EXPECT_EQ(3, complexStruct.intVector[2]);
     EXPECT_TRUE(complexStruct.fieldCluster.object().find("someUnknown")->second == nullptr);
     EXPECT_EQ(size_t(3), complexStruct.fieldCluster.object().find("someOtherUnknown")->second->arraySize());
-    EXPECT_STREQ("4", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[0].c_str());
-    EXPECT_STREQ("5", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[1].c_str());
-    EXPECT_STREQ("6", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[2].c_str());
+    EXPECT_STREQ("4", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[0].str().c_str());
+    EXPECT_STREQ("5", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[1].str().c_str());
+    EXPECT_STREQ("6", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[2].str().c_str());
 }
 
 TEST_HEADER(JsonInput, ReadType)
@@ -2208,9 +2279,9 @@ TEST_HEADER(JsonInput, ReadType)
     EXPECT_EQ(3, complexStruct.intVector[2]);
     EXPECT_TRUE(complexStruct.fieldCluster.object().find("someUnknown")->second == nullptr);
     EXPECT_EQ(size_t(3), complexStruct.fieldCluster.object().find("someOtherUnknown")->second->arraySize());
-    EXPECT_STREQ("4", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[0].c_str());
-    EXPECT_STREQ("5", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[1].c_str());
-    EXPECT_STREQ("6", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[2].c_str());
+    EXPECT_STREQ("4", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[0].str().c_str());
+    EXPECT_STREQ("5", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[1].str().c_str());
+    EXPECT_STREQ("6", complexStruct.fieldCluster.object().find("someOtherUnknown")->second->numberArray()[2].str().c_str());
 }
 
 TEST_HEADER(JsonInput, InProxyReflected)
@@ -2330,4 +2401,170 @@ TEST_HEADER(JsonInput, InOptionals)
     EXPECT_EQ(2, inValueOpt.b->a);
 }
 
+struct PushObj
+{
+    int a = 0;
+    std::string b;
+    std::vector<int> c;
+
+    REFLECT(PushObj, a, b, c)
+};
+
+TEST_HEADER(JsonInput, PushParserChunked)
+{
+    std::string input = "{\"a\":1,\"b\":\"x}]\\\"{\",\"c\":[1,2,3]} {\"a\":2,\"b\":\"\",\"c\":[]}\n{\"a\":3,\"b\":\"y\",\"c\":[4]}";
+    for ( size_t chunkSize = 1; chunkSize <= input.size(); ++chunkSize )
+    {
+        Json::PushParser<PushObj> parser {};
+        std::vector<PushObj> read {};
+        for ( size_t i=0; i<input.size(); i += chunkSize )
+        {
+            parser.feed(std::string_view(input).substr(i, chunkSize));
+            while ( parser.ready() )
+                read.push_back(parser.next());
+        }
+        EXPECT_EQ(0, parser.finish());
+        ASSERT_EQ(3, read.size());
+        EXPECT_EQ(1, read[0].a);
+        EXPECT_STREQ("x}]\"{", read[0].b.c_str());
+        EXPECT_EQ(std::vector<int>({1, 2, 3}), read[0].c);
+        EXPECT_EQ(2, read[1].a);
+        EXPECT_TRUE(read[1].b.empty());
+        EXPECT_TRUE(read[1].c.empty());
+        EXPECT_EQ(3, read[2].a);
+        EXPECT_EQ(std::vector<int>({4}), read[2].c);
+    }
+}
+
+TEST_HEADER(JsonInput, PushParserPrimitives)
+{
+    Json::PushParser<int> parser {};
+    EXPECT_EQ(0, parser.feed("12"));
+    EXPECT_EQ(0, parser.feed("34"));
+    EXPECT_EQ(1, parser.feed(" 5"));
+    EXPECT_EQ(1234, parser.next());
+    EXPECT_FALSE(parser.ready());
+    EXPECT_EQ(1, parser.finish());
+    EXPECT_EQ(5, parser.next());
+
+    Json::PushParser<std::string> stringParser {};
+    EXPECT_EQ(0, stringParser.feed("\"ab"));
+    EXPECT_EQ(1, stringParser.feed("c\""));
+    EXPECT_STREQ("abc", stringParser.next().c_str());
+
+    Json::PushParser<PushObj> incomplete {};
+    EXPECT_EQ(0, incomplete.feed("{\"a\":1"));
+    EXPECT_THROW(incomplete.finish(), Json::UnexpectedInputEnd);
+
+    Json::PushParser<int> trailing {};
+    EXPECT_THROW(trailing.feed("1234abc 5 "), Json::UnexpectedTrailingCharacter);
+    EXPECT_EQ(2, trailing.feed("6 ")); // Input after the value which threw is kept
+    EXPECT_EQ(5, trailing.next());
+    EXPECT_EQ(6, trailing.next());
+
+    Json::PushParser<int> spanningTrailing {};
+    EXPECT_EQ(0, spanningTrailing.feed("12"));
+    EXPECT_THROW(spanningTrailing.feed("x 7 8"), Json::UnexpectedTrailingCharacter);
+    EXPECT_EQ(2, spanningTrailing.finish());
+    EXPECT_EQ(7, spanningTrailing.next());
+    EXPECT_EQ(8, spanningTrailing.next());
+}
+
+#ifdef USE_BUFFERED_STREAMS
+TEST_HEADER(JsonInput, WindowedStringBuffer)
+{
+    std::string input = "[";
+    for ( size_t i=0; i<200; ++i )
+        input += std::string(i == 0 ? "" : ",") + "{ \"a\": " + std::to_string(i) + ", \"b\": \"str\", \"c\": [1, 2, 3] }";
+    input += "]";
+
+    std::stringstream src(input);
+    RareBufferedStream::IStringBuffer window(src, 32);
+    std::vector<PushObj> objs {};
+    window >> Json::in(objs);
+
+    ASSERT_EQ(size_t(200), objs.size());
+    EXPECT_EQ(199, objs.back().a);
+    EXPECT_STREQ("str", objs.back().b.c_str());
+    EXPECT_EQ(size_t(3), objs.back().c.size());
+    EXPECT_GT(window.discardedSize(), input.size()-64);
+}
+#endif
+
+TEST_HEADER(JsonInput, MappedFile)
+{
+    std::string path = (std::filesystem::temp_directory_path() / "rarecpp_mapped_file_test.json").string();
+    {
+        std::ofstream file(path, std::ios_base::binary);
+        file << "{\"a\":3,\"b\":\"mapped\",\"c\":[4,5]}";
+    }
+
+    RareBufferedStream::MappedFile mapped(path);
+    ASSERT_TRUE(mapped.isOpen());
+    PushObj fromView = Json::read<PushObj>(mapped.view());
+    EXPECT_EQ(3, fromView.a);
+    EXPECT_STREQ("mapped", fromView.b.c_str());
+
+    RareBufferedStream::MappedStringBuffer is(path);
+    ASSERT_TRUE(is.isOpen());
+    EXPECT_EQ(mapped.view().size(), is.view().size());
+    PushObj fromStream {};
+    is >> Json::in(fromStream);
+    ASSERT_EQ(size_t(2), fromStream.c.size());
+    EXPECT_EQ(5, fromStream.c[1]);
+
+    mapped.close();
+    std::remove(path.c_str());
+
+    RareBufferedStream::MappedStringBuffer missing(path);
+    EXPECT_FALSE(missing.isOpen());
+    EXPECT_TRUE(missing.fail());
+}
+
+TEST_HEADER(JsonInput, PmrContext)
+{
+    char arena[4096] {};
+    std::pmr::monotonic_buffer_resource resource(arena, sizeof(arena), std::pmr::null_memory_resource());
+    auto context = std::make_shared<Json::Context>(&resource);
+
+    PushObj obj {};
+    std::stringstream input("{\"a\":3,\"b\":\"a string long enough to not fit in small-string storage\",\"c\":[4,5],\"unknownFieldWithALongName\":1}");
+    input >> Json::in(obj, context);
+    EXPECT_EQ(3, obj.a);
+    EXPECT_STREQ("a string long enough to not fit in small-string storage", obj.b.c_str());
+    ASSERT_EQ(size_t(2), obj.c.size());
+
+    std::pmr::string str(&resource);
+    input.str("\"some \\\"escaped\\\" text\"");
+    input.clear();
+    input >> Json::in(str, context);
+    EXPECT_STREQ("some \"escaped\" text", str.c_str());
+}
+
+TEST_HEADER(JsonInput, ReadFields)
+{
+    std::vector<std::pair<std::string, std::string>> fields {};
+    Json::readFields(" { \"a\": 1 , \"b\\\"c\":[1, {\"d\": \"}\"}],\"e\" : null }\n", [&](std::string_view name, std::string_view value) {
+        fields.emplace_back(name, value);
+    });
+    ASSERT_EQ(size_t(3), fields.size());
+    EXPECT_EQ("a", fields[0].first);
+    EXPECT_EQ("1", fields[0].second);
+    EXPECT_EQ("b\"c", fields[1].first);
+    EXPECT_EQ("[1, {\"d\": \"}\"}]", fields[1].second);
+    EXPECT_EQ("e", fields[2].first);
+    EXPECT_EQ("null", fields[2].second);
+
+    size_t total = 0;
+    Json::readFields("{}", [&](std::string_view, std::string_view) { ++total; });
+    EXPECT_EQ(size_t(0), total);
+
+    auto ignore = [](std::string_view, std::string_view) {};
+    EXPECT_THROW(Json::readFields("{\"a\": ]}", ignore), Json::Exception);
+    EXPECT_THROW(Json::readFields("{\"a\": [1}]}", ignore), Json::Exception);
+    EXPECT_THROW(Json::readFields("{\"a\": 1", ignore), Json::UnexpectedInputEnd);
+    EXPECT_THROW(Json::readFields("[1]", ignore), Json::Exception);
+    EXPECT_THROW(Json::readFields("{\"a\": 1} 2", ignore), Json::UnexpectedTrailingCharacter);
+}
+
 #endif
\ No newline at end of file
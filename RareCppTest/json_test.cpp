@@ -389,9 +389,21 @@ TEST_HEADER(JsonSharedTest, SuperTypeToJsonFieldName)
         lastClassScope == std::string::npos ? myClassStr.c_str() : myClassStr.substr(lastClassScope+1).c_str());
 }
 
+TEST_HEADER(JsonSharedTest, SuperTypeJsonFieldName)
+{
+    constexpr std::string_view myStructName = Json::superTypeJsonFieldName<MyStruct>;
+    EXPECT_EQ(Json::superTypeToJsonFieldName<MyStruct>(), myStructName);
+    EXPECT_EQ("\"" + Json::superTypeToJsonFieldName<MyClass>() + "\"", std::string(Json::superTypeJsonFieldName<MyClass>.quoted));
+
+    struct Lower {};
+    std::string expected = "__" + Json::simplifyTypeStr(std::string(RareTs::toStr<Lower>()));
+    EXPECT_EQ(expected, Json::superTypeJsonFieldName<Lower>.view());
+}
+
 TEST_HEADER(JsonSharedTest, FieldClusterToJsonFieldName)
 {
     EXPECT_STREQ("____fieldCluster", Json::fieldClusterToJsonFieldName().c_str());
+    EXPECT_EQ("____fieldCluster", Json::fieldClusterJsonFieldName);
 }
 
 TEST_HEADER(JsonGenericTest, JsonField)
@@ -496,53 +508,118 @@ TEST_HEADER(JsonGenericTest, Bool)
     EXPECT_THROW(constCtor.mixedArray(), Json::Value::TypeMismatch);
 }
 
+TEST_HEADER(JsonGenericTest, Numeric)
+{
+    EXPECT_EQ(Json::Numeric::Kind::Int, Json::Numeric("-42").kind());
+    EXPECT_EQ(Json::Numeric::Kind::Uint, Json::Numeric("18446744073709551615").kind());
+    EXPECT_EQ(Json::Numeric::Kind::Double, Json::Numeric("13.5").kind());
+    EXPECT_EQ(Json::Numeric::Kind::Text, Json::Numeric("1e5").kind());
+    EXPECT_EQ(Json::Numeric::Kind::Text, Json::Numeric("007").kind());
+    EXPECT_EQ(Json::Numeric::Kind::Text, Json::Numeric("123456789012345678901234567890").kind());
+    EXPECT_LE(sizeof(Json::Numeric), 2*sizeof(uint64_t));
+
+    for ( const char* text : { "0", "-42", "18446744073709551615", "13.5", "-12.322", "0.1", "1e5", "007", "-0", "1.0" } )
+        EXPECT_STREQ(text, Json::Numeric(text).str().c_str());
+
+    int integer = 0;
+    EXPECT_TRUE(Json::Numeric("-42").get(integer));
+    EXPECT_EQ(-42, integer);
+    EXPECT_EQ(100000.0, Json::Numeric("1e5").as<double>());
+    EXPECT_FALSE(Json::Numeric("13.5").get(integer)); // Would lose the fractional part
+    EXPECT_FALSE(Json::Numeric("qwerty").get(integer));
+    EXPECT_EQ(-42, integer);
+
+    uint8_t small = 0;
+    EXPECT_FALSE(Json::Numeric("256").get(small));
+    EXPECT_FALSE(Json::Numeric("-1").get(small));
+    EXPECT_FALSE(Json::Numeric("18446744073709551615").get(small));
+    EXPECT_FALSE(Json::Numeric("1e300").get(small));
+    EXPECT_TRUE(Json::Numeric("255").get(small));
+    EXPECT_EQ(255, small);
+    EXPECT_FALSE(Json::Numeric(1e300).get(integer));
+    EXPECT_FALSE(Json::Numeric(std::numeric_limits<double>::quiet_NaN()).get(integer));
+    EXPECT_TRUE(Json::Numeric(2.0).get(integer));
+    EXPECT_EQ(2, integer);
+
+    int64_t signedInteger = 0;
+    EXPECT_FALSE(Json::Numeric("18446744073709551615").get(signedInteger));
+    EXPECT_FALSE(Json::Numeric(9223372036854775808.0).get(signedInteger));
+    EXPECT_TRUE(Json::Numeric(-9223372036854775808.0).get(signedInteger));
+    EXPECT_EQ(std::numeric_limits<int64_t>::min(), signedInteger);
+
+    bool flag = false;
+    EXPECT_FALSE(Json::Numeric("2").get(flag));
+    EXPECT_TRUE(Json::Numeric("1").get(flag));
+    EXPECT_TRUE(flag);
+
+    double decimal = 0.0;
+    float single = 0.0f;
+    EXPECT_FALSE(Json::Numeric("9007199254740993").get(decimal)); // 2^53+1 isn't representable as a double
+    EXPECT_TRUE(Json::Numeric("9007199254740992").get(decimal));
+    EXPECT_EQ(9007199254740992.0, decimal);
+    EXPECT_FALSE(Json::Numeric("18446744073709551615").get(decimal));
+    EXPECT_FALSE(Json::Numeric(1e300).get(single));
+    EXPECT_FALSE(Json::Numeric("1e300").get(single));
+    EXPECT_TRUE(Json::Numeric(13.5).get(single));
+    EXPECT_EQ(13.5f, single);
+
+    Json::Numeric text("1e5");
+    Json::Numeric copied = text;
+    Json::Numeric moved = std::move(text);
+    EXPECT_STREQ("1e5", copied.str().c_str());
+    EXPECT_STREQ("1e5", moved.str().c_str());
+    EXPECT_EQ(copied, moved);
+    EXPECT_STREQ("553", Json::Numeric(short(553)).str().c_str());
+    EXPECT_STREQ("2.5", Json::Numeric(2.5).str().c_str());
+}
+
 TEST_HEADER(JsonGenericTest, Number)
 {
     Json::Number ctor;
-    EXPECT_STREQ("0", ctor.number().c_str());
+    EXPECT_STREQ("0", ctor.number().str().c_str());
 
     std::string numericValue("9000.1337");
     Json::Number valueConstruct(numericValue);
-    EXPECT_STREQ(numericValue.c_str(), valueConstruct.number().c_str());
+    EXPECT_STREQ(numericValue.c_str(), valueConstruct.number().str().c_str());
 
     Json::Number copyConstruct(valueConstruct);
-    EXPECT_STREQ(numericValue.c_str(), copyConstruct.number().c_str());
+    EXPECT_STREQ(numericValue.c_str(), copyConstruct.number().str().c_str());
 
     auto ctorMake = std::make_shared<Json::Number>();
-    EXPECT_STREQ("0", ctorMake->number().c_str());
+    EXPECT_STREQ("0", ctorMake->number().str().c_str());
 
     const char charArrayParam[] = "qwerty";
     auto charArrayMake = std::make_shared<Json::Number>(charArrayParam);
-    EXPECT_STREQ("qwerty", charArrayMake->number().c_str());
+    EXPECT_STREQ("qwerty", charArrayMake->number().str().c_str());
 
     const char* charPtrParam = &charArrayParam[0];
     auto charPtrMake = std::make_shared<Json::Number>(charPtrParam);
-    EXPECT_STREQ("qwerty", charPtrMake->number().c_str());
+    EXPECT_STREQ("qwerty", charPtrMake->number().str().c_str());
 
     const std::string strParam = "uiop";
     auto stringMake = std::make_shared<Json::Number>(strParam);
-    EXPECT_STREQ("uiop", stringMake->number().c_str());
+    EXPECT_STREQ("uiop", stringMake->number().str().c_str());
 
     auto constCharMake = std::make_shared<Json::Number>("66.7");
-    EXPECT_STREQ("66.7", constCharMake->number().c_str());
+    EXPECT_STREQ("66.7", constCharMake->number().str().c_str());
 
     auto valueMake = std::make_shared<Json::Number>(numericValue);
-    EXPECT_STREQ(numericValue.c_str(), valueMake->number().c_str());
+    EXPECT_STREQ(numericValue.c_str(), valueMake->number().str().c_str());
 
     auto copyMake = std::make_shared<Json::Number>(valueConstruct);
-    EXPECT_STREQ(numericValue.c_str(), copyMake->number().c_str());
+    EXPECT_STREQ(numericValue.c_str(), copyMake->number().str().c_str());
 
     short number = 553;
     auto numberCastMake = std::make_shared<Json::Number>(number);
-    EXPECT_STREQ(std::to_string(number).c_str(), numberCastMake->number().c_str());
+    EXPECT_STREQ(std::to_string(number).c_str(), numberCastMake->number().str().c_str());
 
     Json::Number other = valueConstruct;
-    EXPECT_STREQ(numericValue.c_str(), other.number().c_str());
+    EXPECT_STREQ(numericValue.c_str(), other.number().str().c_str());
 
     EXPECT_EQ(Json::Value::Type::Number, ctor.type());
     
     EXPECT_THROW(ctor.boolean(), Json::Value::TypeMismatch);
-    EXPECT_STREQ("0", ctor.number().c_str());
+    EXPECT_STREQ("0", ctor.number().str().c_str());
     EXPECT_THROW(ctor.string(), Json::Value::TypeMismatch);
     EXPECT_THROW(ctor.object(), Json::Value::TypeMismatch);
     EXPECT_THROW(ctor.orderedObject(), Json::Value::TypeMismatch);
@@ -550,7 +627,7 @@ TEST_HEADER(JsonGenericTest, Number)
     const Json::Number & constCtor = ctor;
     
     EXPECT_THROW(constCtor.boolean(), Json::Value::TypeMismatch);
-    EXPECT_STREQ("0", constCtor.number().c_str());
+    EXPECT_STREQ("0", constCtor.number().str().c_str());
     EXPECT_THROW(constCtor.string(), Json::Value::TypeMismatch);
     EXPECT_THROW(constCtor.object(), Json::Value::TypeMismatch);
     EXPECT_THROW(constCtor.orderedObject(), Json::Value::TypeMismatch);
@@ -922,15 +999,15 @@ TEST_HEADER(JsonGenericTest, NumberArray)
     values.push_back("45");
     Json::NumberArray valueConstruct(values);
     EXPECT_EQ(size_t(3), valueConstruct.arraySize());
-    EXPECT_STREQ("0", valueConstruct.numberArray()[0].c_str());
-    EXPECT_STREQ("1", valueConstruct.numberArray()[1].c_str());
-    EXPECT_STREQ("45", valueConstruct.numberArray()[2].c_str());
+    EXPECT_STREQ("0", valueConstruct.numberArray()[0].str().c_str());
+    EXPECT_STREQ("1", valueConstruct.numberArray()[1].str().c_str());
+    EXPECT_STREQ("45", valueConstruct.numberArray()[2].str().c_str());
 
     Json::NumberArray copyConstruct(valueConstruct);
     EXPECT_EQ(size_t(3), copyConstruct.arraySize());
-    EXPECT_STREQ("0", copyConstruct.numberArray()[0].c_str());
-    EXPECT_STREQ("1", copyConstruct.numberArray()[1].c_str());
-    EXPECT_STREQ("45", copyConstruct.numberArray()[2].c_str());
+    EXPECT_STREQ("0", copyConstruct.numberArray()[0].str().c_str());
+    EXPECT_STREQ("1", copyConstruct.numberArray()[1].str().c_str());
+    EXPECT_STREQ("45", copyConstruct.numberArray()[2].str().c_str());
 
     auto ctorMake = std::make_shared<Json::NumberArray>();
     EXPECT_TRUE(ctorMake->numberArray().empty());
@@ -938,21 +1015,21 @@ TEST_HEADER(JsonGenericTest, NumberArray)
 
     auto valueMake = std::make_shared<Json::NumberArray>(values);
     EXPECT_EQ(size_t(3), valueMake->arraySize());
-    EXPECT_STREQ("0", valueMake->numberArray()[0].c_str());
-    EXPECT_STREQ("1", valueMake->numberArray()[1].c_str());
-    EXPECT_STREQ("45", valueMake->numberArray()[2].c_str());
+    EXPECT_STREQ("0", valueMake->numberArray()[0].str().c_str());
+    EXPECT_STREQ("1", valueMake->numberArray()[1].str().c_str());
+    EXPECT_STREQ("45", valueMake->numberArray()[2].str().c_str());
 
     auto copyMake = std::make_shared<Json::NumberArray>(values);
     EXPECT_EQ(size_t(3), copyMake->arraySize());
-    EXPECT_STREQ("0", copyMake->numberArray()[0].c_str());
-    EXPECT_STREQ("1", copyMake->numberArray()[1].c_str());
-    EXPECT_STREQ("45", copyMake->numberArray()[2].c_str());
+    EXPECT_STREQ("0", copyMake->numberArray()[0].str().c_str());
+    EXPECT_STREQ("1", copyMake->numberArray()[1].str().c_str());
+    EXPECT_STREQ("45", copyMake->numberArray()[2].str().c_str());
 
     Json::NumberArray other = values;
     EXPECT_EQ(size_t(3), other.arraySize());
-    EXPECT_STREQ("0", other.numberArray()[0].c_str());
-    EXPECT_STREQ("1", other.numberArray()[1].c_str());
-    EXPECT_STREQ("45", other.numberArray()[2].c_str());
+    EXPECT_STREQ("0", other.numberArray()[0].str().c_str());
+    EXPECT_STREQ("1", other.numberArray()[1].str().c_str());
+    EXPECT_STREQ("45", other.numberArray()[2].str().c_str());
 
     EXPECT_EQ(Json::Value::Type::NumberArray, ctor.type());
 
@@ -1081,7 +1158,7 @@ TEST_HEADER(JsonGenericTest, ObjectArray)
     EXPECT_STREQ("firstTwo", first.find("firstTwo")->first.c_str());
     EXPECT_STREQ("firstThree", first.find("firstThree")->first.c_str());
     EXPECT_EQ(false, first.find("firstOne")->second->boolean());
-    EXPECT_STREQ("1234", first.find("firstTwo")->second->number().c_str());
+    EXPECT_STREQ("1234", first.find("firstTwo")->second->number().str().c_str());
     EXPECT_STREQ("asdf", first.find("firstThree")->second->string().c_str());
     auto second = valueConstruct.objectArray()[1];
     EXPECT_TRUE(second.empty());
@@ -1096,7 +1173,7 @@ TEST_HEADER(JsonGenericTest, ObjectArray)
     EXPECT_STREQ("firstTwo", first.find("firstTwo")->first.c_str());
     EXPECT_STREQ("firstThree", first.find("firstThree")->first.c_str());
     EXPECT_EQ(false, first.find("firstOne")->second->boolean());
-    EXPECT_STREQ("1234", first.find("firstTwo")->second->number().c_str());
+    EXPECT_STREQ("1234", first.find("firstTwo")->second->number().str().c_str());
     EXPECT_STREQ("asdf", first.find("firstThree")->second->string().c_str());
     second = copyConstruct.objectArray()[1];
     EXPECT_TRUE(second.empty());
@@ -1115,7 +1192,7 @@ TEST_HEADER(JsonGenericTest, ObjectArray)
     EXPECT_STREQ("firstTwo", first.find("firstTwo")->first.c_str());
     EXPECT_STREQ("firstThree", first.find("firstThree")->first.c_str());
     EXPECT_EQ(false, first.find("firstOne")->second->boolean());
-    EXPECT_STREQ("1234", first.find("firstTwo")->second->number().c_str());
+    EXPECT_STREQ("1234", first.find("firstTwo")->second->number().str().c_str());
     EXPECT_STREQ("asdf", first.find("firstThree")->second->string().c_str());
     second = valueMake->objectArray()[1];
     EXPECT_TRUE(second.empty());
@@ -1130,7 +1207,7 @@ TEST_HEADER(JsonGenericTest, ObjectArray)
     EXPECT_STREQ("firstTwo", first.find("firstTwo")->first.c_str());
     EXPECT_STREQ("firstThree", first.find("firstThree")->first.c_str());
     EXPECT_EQ(false, first.find("firstOne")->second->boolean());
-    EXPECT_STREQ("1234", first.find("firstTwo")->second->number().c_str());
+    EXPECT_STREQ("1234", first.find("firstTwo")->second->number().str().c_str());
     EXPECT_STREQ("asdf", first.find("firstThree")->second->string().c_str());
     second = copyMake->objectArray()[1];
     EXPECT_TRUE(second.empty());
@@ -1145,7 +1222,7 @@ TEST_HEADER(JsonGenericTest, ObjectArray)
     EXPECT_STREQ("firstTwo", first.find("firstTwo")->first.c_str());
     EXPECT_STREQ("firstThree", first.find("firstThree")->first.c_str());
     EXPECT_EQ(false, first.find("firstOne")->second->boolean());
-    EXPECT_STREQ("1234", first.find("firstTwo")->second->number().c_str());
+    EXPECT_STREQ("1234", first.find("firstTwo")->second->number().str().c_str());
     EXPECT_STREQ("asdf", first.find("firstThree")->second->string().c_str());
     second = other.objectArray()[1];
     EXPECT_TRUE(second.empty());
@@ -1209,7 +1286,7 @@ TEST_HEADER(JsonGenericTest, OrderedObjectArray)
     EXPECT_STREQ("firstTwo", first[1].first.c_str());
     EXPECT_STREQ("firstThree", first[2].first.c_str());
     EXPECT_EQ(false, first[0].second->boolean());
-    EXPECT_STREQ("1234", first[1].second->number().c_str());
+    EXPECT_STREQ("1234", first[1].second->number().str().c_str());
     EXPECT_STREQ("asdf", first[2].second->string().c_str());
     auto second = valueConstruct.orderedObjectArray()[1];
     EXPECT_TRUE(second.empty());
@@ -1224,7 +1301,7 @@ TEST_HEADER(JsonGenericTest, OrderedObjectArray)
     EXPECT_STREQ("firstTwo", first[1].first.c_str());
     EXPECT_STREQ("firstThree", first[2].first.c_str());
     EXPECT_EQ(false, first[0].second->boolean());
-    EXPECT_STREQ("1234", first[1].second->number().c_str());
+    EXPECT_STREQ("1234", first[1].second->number().str().c_str());
     EXPECT_STREQ("asdf", first[2].second->string().c_str());
     second = copyConstruct.orderedObjectArray()[1];
     EXPECT_TRUE(second.empty());
@@ -1243,7 +1320,7 @@ TEST_HEADER(JsonGenericTest, OrderedObjectArray)
     EXPECT_STREQ("firstTwo", first[1].first.c_str());
     EXPECT_STREQ("firstThree", first[2].first.c_str());
     EXPECT_EQ(false, first[0].second->boolean());
-    EXPECT_STREQ("1234", first[1].second->number().c_str());
+    EXPECT_STREQ("1234", first[1].second->number().str().c_str());
     EXPECT_STREQ("asdf", first[2].second->string().c_str());
     second = valueMake->orderedObjectArray()[1];
     EXPECT_TRUE(second.empty());
@@ -1258,7 +1335,7 @@ TEST_HEADER(JsonGenericTest, OrderedObjectArray)
     EXPECT_STREQ("firstTwo", first[1].first.c_str());
     EXPECT_STREQ("firstThree", first[2].first.c_str());
     EXPECT_EQ(false, first[0].second->boolean());
-    EXPECT_STREQ("1234", first[1].second->number().c_str());
+    EXPECT_STREQ("1234", first[1].second->number().str().c_str());
     EXPECT_STREQ("asdf", first[2].second->string().c_str());
     second = copyMake->orderedObjectArray()[1];
     EXPECT_TRUE(second.empty());
@@ -1273,7 +1350,7 @@ TEST_HEADER(JsonGenericTest, OrderedObjectArray)
     EXPECT_STREQ("firstTwo", first[1].first.c_str());
     EXPECT_STREQ("firstThree", first[2].first.c_str());
     EXPECT_EQ(false, first[0].second->boolean());
-    EXPECT_STREQ("1234", first[1].second->number().c_str());
+    EXPECT_STREQ("1234", first[1].second->number().str().c_str());
     EXPECT_STREQ("asdf", first[2].second->string().c_str());
     second = other.orderedObjectArray()[1];
     EXPECT_TRUE(second.empty());
@@ -1340,7 +1417,7 @@ TEST_HEADER(JsonGenericTest, MixedArray)
     auto nestedNestedNullptr = nestedMixedArray->mixedArray()[0];
     auto nestedNestedNumber = nestedMixedArray->mixedArray()[1];
     EXPECT_TRUE(nullptr == nestedNestedNullptr);
-    EXPECT_STREQ("1234", nestedNestedNumber->number().c_str());
+    EXPECT_STREQ("1234", nestedNestedNumber->number().str().c_str());
     EXPECT_TRUE(nestedBoolArray->boolArray()[0]);
     EXPECT_FALSE(nestedBoolArray->boolArray()[1]);
     EXPECT_TRUE(nestedBoolArray->boolArray()[2]);
@@ -1361,7 +1438,7 @@ TEST_HEADER(JsonGenericTest, MixedArray)
     nestedNestedNullptr = nestedMixedArray->mixedArray()[0];
     nestedNestedNumber = nestedMixedArray->mixedArray()[1];
     EXPECT_TRUE(nullptr == nestedNestedNullptr);
-    EXPECT_STREQ("1234", nestedNestedNumber->number().c_str());
+    EXPECT_STREQ("1234", nestedNestedNumber->number().str().c_str());
     EXPECT_TRUE(nestedBoolArray->boolArray()[0]);
     EXPECT_FALSE(nestedBoolArray->boolArray()[1]);
     EXPECT_TRUE(nestedBoolArray->boolArray()[2]);
@@ -1386,7 +1463,7 @@ TEST_HEADER(JsonGenericTest, MixedArray)
     nestedNestedNullptr = nestedMixedArray->mixedArray()[0];
     nestedNestedNumber = nestedMixedArray->mixedArray()[1];
     EXPECT_TRUE(nullptr == nestedNestedNullptr);
-    EXPECT_STREQ("1234", nestedNestedNumber->number().c_str());
+    EXPECT_STREQ("1234", nestedNestedNumber->number().str().c_str());
     EXPECT_TRUE(nestedBoolArray->boolArray()[0]);
     EXPECT_FALSE(nestedBoolArray->boolArray()[1]);
     EXPECT_TRUE(nestedBoolArray->boolArray()[2]);
@@ -1407,7 +1484,7 @@ TEST_HEADER(JsonGenericTest, MixedArray)
     nestedNestedNullptr = nestedMixedArray->mixedArray()[0];
     nestedNestedNumber = nestedMixedArray->mixedArray()[1];
     EXPECT_TRUE(nullptr == nestedNestedNullptr);
-    EXPECT_STREQ("1234", nestedNestedNumber->number().c_str());
+    EXPECT_STREQ("1234", nestedNestedNumber->number().str().c_str());
     EXPECT_TRUE(nestedBoolArray->boolArray()[0]);
     EXPECT_FALSE(nestedBoolArray->boolArray()[1]);
     EXPECT_TRUE(nestedBoolArray->boolArray()[2]);
@@ -1428,7 +1505,7 @@ TEST_HEADER(JsonGenericTest, MixedArray)
     nestedNestedNullptr = nestedMixedArray->mixedArray()[0];
     nestedNestedNumber = nestedMixedArray->mixedArray()[1];
     EXPECT_TRUE(nullptr == nestedNestedNullptr);
-    EXPECT_STREQ("1234", nestedNestedNumber->number().c_str());
+    EXPECT_STREQ("1234", nestedNestedNumber->number().str().c_str());
     EXPECT_TRUE(nestedBoolArray->boolArray()[0]);
     EXPECT_FALSE(nestedBoolArray->boolArray()[1]);
     EXPECT_TRUE(nestedBoolArray->boolArray()[2]);
@@ -3751,6 +3828,61 @@ TEST_HEADER(JsonOutputTest, JsonWritePrettyReturn)
     EXPECT_STREQ(objStreamCompare.str().c_str(), output.c_str());
 }
 
+TEST_HEADER(JsonOutputTest, JsonMeasure)
+{
+    NestedObj nestedObj = { false, { 1, 2, 3 } };
+    AnObjectTest anObject = { 4, "aString", nestedObj };
+
+    EXPECT_EQ(Json::write(anObject).size(), Json::measure(anObject));
+    EXPECT_EQ(Json::writePretty(anObject).size(), Json::measurePretty(anObject));
+
+    std::vector<int> large(1000, 123456);
+    EXPECT_EQ(Json::write(large).size(), Json::measure(large));
+    EXPECT_EQ(Json::writePretty(large).size(), Json::measurePretty(large));
+}
+
+TEST_HEADER(JsonOutputTest, JsonWriteSpan)
+{
+    NestedObj nestedObj = { false, { 1, 2, 3 } };
+    AnObjectTest anObject = { 4, "aString", nestedObj };
+
+    std::string output(Json::measure(anObject), '\0');
+    size_t written = Json::write(anObject, std::span<char>(output));
+    EXPECT_EQ(output.size(), written);
+    EXPECT_STREQ("{\"integer\":4,\"str\":\"aString\",\"nestedObj\":{\"bool\":false,\"ray\":[1,2,3]}}", output.c_str());
+
+    std::string prettyOutput(Json::measurePretty(anObject), '\0');
+    written = Json::writePretty(anObject, std::span<char>(prettyOutput));
+    EXPECT_EQ(prettyOutput.size(), written);
+    EXPECT_STREQ(Json::writePretty(anObject).c_str(), prettyOutput.c_str());
+
+    char small[8] {};
+    EXPECT_THROW(Json::write(anObject, std::span<char>(small)), Json::OutputBufferExceeded);
+}
+
+TEST_HEADER(JsonOutputTest, JsonMeasureWriteSpanNoAllocation)
+{
+    NestedObj nestedObj = { false, { 1, 2, 3 } };
+    AnObjectTest anObject = { 4, "aString", nestedObj };
+    std::vector<int> large(5000, 123456); // Output is larger than any internal buffering
+    auto context = std::make_shared<Json::Context>();
+    std::string expected = Json::write(large, context);
+    std::string output(Json::measure(large, context), '\0'); // Also warms up any per-thread buffers
+    char small[8] {};
+    EXPECT_THROW(Json::write(anObject, std::span<char>(small), context), Json::OutputBufferExceeded);
+
+    std::size_t allocations = globalAllocations;
+    std::size_t measured = Json::measure(large, context);
+    std::size_t measuredPretty = Json::measurePretty(anObject, context);
+    std::size_t written = Json::write(large, std::span<char>(output), context);
+    EXPECT_EQ(allocations, globalAllocations.load());
+
+    EXPECT_EQ(expected.size(), measured);
+    EXPECT_EQ(Json::writePretty(anObject).size(), measuredPretty);
+    EXPECT_EQ(expected.size(), written);
+    EXPECT_STREQ(expected.c_str(), output.c_str());
+}
+
 TEST_HEADER(JsonOutputTest, Performance_1000_StringStream)
 {
 #ifdef RUN_PERFORMANCE_TESTS
@@ -3,10 +3,14 @@
 #include <rarecpp/json.h>
 #include <rarecpp/reflect.h>
 #include <rarecpp/string_buffer.h>
+#include <atomic>
+#include <cstddef>
 using namespace RareTs;
 using namespace RareBufferedStream;
 using Json::Statics;
 
+extern std::atomic<std::size_t> globalAllocations; // Calls to the global operator new, replaced in json_test_run_buffered.cpp
+
 struct CustomizeNoSpecialization
 {
     int integer;
@@ -1,4 +1,8 @@
 #define USE_BUFFERED_STREAMS
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
 
 #define GET_RUNJSONTESTSRC_INCLUDES
 #include "json_test.cpp"
@@ -12,3 +16,24 @@ namespace Buffered
 }
 
 #undef USE_BUFFERED_STREAMS
+
+std::atomic<std::size_t> globalAllocations {0};
+
+void* operator new(std::size_t size)
+{
+    ++globalAllocations;
+    if ( void* allocated = std::malloc(size == 0 ? 1 : size) )
+        return allocated;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* allocated) noexcept
+{
+    std::free(allocated);
+}
+
+void operator delete(void* allocated, std::size_t) noexcept
+{
+    std::free(allocated);
+}
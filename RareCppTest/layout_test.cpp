@@ -0,0 +1,93 @@
+#include <rarecpp/layout.h>
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace LayoutTest
+{
+    struct Padded
+    {
+        char a;
+        double b;
+        char c;
+
+        static int staticValue;
+        int method() { return 0; }
+
+        REFLECT(Padded, a, b, c, staticValue, method)
+    };
+
+    int Padded::staticValue = 0;
+
+    struct Packed
+    {
+        std::int32_t a;
+        std::int16_t b;
+        std::int16_t c;
+
+        REFLECT(Packed, a, b, c)
+    };
+
+    struct Empty
+    {
+        REFLECT(Empty)
+    };
+}
+
+using namespace LayoutTest;
+
+TEST(LayoutTest, Members)
+{
+    using Layout = RareTs::layout<Padded>;
+    EXPECT_EQ(sizeof(Padded), Layout::size);
+    EXPECT_EQ(alignof(Padded), Layout::alignment);
+    ASSERT_EQ(size_t(3), Layout::members.size());
+
+    EXPECT_EQ(std::string_view("a"), Layout::members[0].name);
+    EXPECT_EQ(size_t(0), Layout::members[0].index);
+    EXPECT_EQ(offsetof(Padded, a), Layout::members[0].offset);
+    EXPECT_EQ(size_t(1), Layout::members[0].size);
+    EXPECT_EQ(size_t(1), Layout::members[0].alignment);
+    EXPECT_EQ(offsetof(Padded, b) - 1, Layout::members[0].padding);
+
+    EXPECT_EQ(std::string_view("b"), Layout::members[1].name);
+    EXPECT_EQ(offsetof(Padded, b), Layout::members[1].offset);
+    EXPECT_EQ(sizeof(double), Layout::members[1].size);
+    EXPECT_EQ(alignof(double), Layout::members[1].alignment);
+    EXPECT_EQ(size_t(0), Layout::members[1].padding);
+
+    EXPECT_EQ(std::string_view("c"), Layout::members[2].name);
+    EXPECT_EQ(sizeof(Padded) - offsetof(Padded, c) - 1, Layout::members[2].padding);
+
+    EXPECT_EQ(size_t(0), Layout::members_offset);
+    EXPECT_EQ(sizeof(double) + 2, Layout::member_bytes);
+    EXPECT_EQ(sizeof(Padded) - sizeof(double) - 2, Layout::padding);
+}
+
+TEST(LayoutTest, OptimalOrder)
+{
+    using Layout = RareTs::layout<Padded>;
+    constexpr auto order = Layout::optimal_order;
+    ASSERT_EQ(size_t(3), order.size());
+    EXPECT_EQ(size_t(1), order[0]);
+    EXPECT_EQ(size_t(0), order[1]);
+    EXPECT_EQ(size_t(2), order[2]);
+
+    struct Reordered { double b; char a; char c; };
+    EXPECT_EQ(sizeof(Reordered), Layout::optimal_size);
+    EXPECT_EQ(sizeof(Reordered) - sizeof(double) - 2, Layout::optimal_padding);
+    EXPECT_LT(Layout::optimal_size, Layout::size);
+
+    EXPECT_EQ(sizeof(Packed), RareTs::layout<Packed>::optimal_size);
+    EXPECT_EQ(size_t(0), RareTs::layout<Empty>::members.size());
+    EXPECT_EQ(size_t(0), RareTs::layout<Empty>::padding);
+}
+
+TEST(LayoutTest, MaxPadding)
+{
+    static_assert(RareTs::max_padding<Packed, 0>);
+    static_assert(RareTs::max_padding<Padded, sizeof(Padded) - sizeof(double) - 2>);
+    static_assert(!RareTs::max_padding<Padded, 0>);
+    EXPECT_EQ(size_t(0), RareTs::layout<Packed>::padding);
+}
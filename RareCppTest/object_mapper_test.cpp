@@ -4,6 +4,7 @@
 #include <istream>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <string>
 #include <tuple>
@@ -842,6 +843,293 @@ TEST(RareMapperTest, MapRecurse)
     EXPECT_EQ(mapDest.e[1].a, 7);
 }
 
+namespace MoveMapped
+{
+    struct Source_string {
+        std::string a;
+        REFLECT(Source_string, a)
+    };
+    struct Dest_string {
+        std::string a;
+        REFLECT(Dest_string, a)
+    };
+
+    struct Dest
+    {
+        std::string name;
+        std::vector<Dest_string> items;
+        std::unique_ptr<Dest_string> owned;
+        std::shared_ptr<Dest_string> shared;
+        std::pair<std::string, int> pair;
+        std::tuple<Dest_string, int> tuple;
+        std::string first;
+        std::string second;
+
+        REFLECT(Dest, name, items, owned, shared, pair, tuple, first, second)
+    };
+
+    struct Source
+    {
+        std::string name;
+        std::vector<Source_string> items;
+        std::unique_ptr<Source_string> owned;
+        std::shared_ptr<Source_string> shared;
+        std::pair<std::string, int> pair;
+        std::tuple<Source_string, int> tuple;
+        std::string first;
+
+        REFLECT(Source, name, items, owned, shared, pair, tuple, first)
+    };
+
+    struct Noted_Dest
+    {
+        std::string a;
+        std::string b;
+        std::vector<int> c;
+
+        REFLECT(Noted_Dest, a, b, c)
+    };
+
+    struct Noted_Source
+    {
+        std::string x;
+        std::vector<int> y;
+
+        REFLECT(Noted_Source, x, y)
+
+        NOTE(ObjectMappings, RareMapper::createMapping<Noted_Source, Noted_Dest>().x->a().x->b().y->c().unidirectional())
+    };
+
+    const std::string longText = "a string long enough to be heap allocated";
+
+    struct Secret {
+        std::string a;
+        REFLECT(Secret, a)
+    };
+    struct Redacted {
+        std::string a;
+        REFLECT(Redacted, a)
+    };
+    struct Masked {
+        std::string a;
+        REFLECT(Masked, a)
+    };
+}
+
+template <> void RareMapper::map(MoveMapped::Redacted & redacted, const MoveMapped::Secret &)
+{
+    redacted.a = "***";
+}
+template <> struct RareMapper::IsSpecialized<MoveMapped::Redacted, MoveMapped::Secret> : std::true_type {};
+
+template <> void RareMapper::map(MoveMapped::Masked & masked, const MoveMapped::Secret &) // Not marked with IsSpecialized
+{
+    masked.a = "###";
+}
+
+TEST(RareMapperTest, MapRvalues)
+{
+    using namespace MoveMapped;
+    auto makeSource = [](){
+        Source source {};
+        source.name = longText;
+        source.items = { Source_string{longText}, Source_string{longText} };
+        source.owned = std::make_unique<Source_string>(Source_string{longText});
+        source.shared = std::make_shared<Source_string>(Source_string{longText});
+        source.pair = { longText, 1 };
+        source.tuple = { Source_string{longText}, 2 };
+        source.first = longText;
+        return source;
+    };
+
+    Source source = makeSource();
+    Dest dest {};
+    RareMapper::map(dest, source); // Lvalues are copied
+    EXPECT_EQ(longText, source.name);
+    EXPECT_EQ(longText, source.items[1].a);
+    EXPECT_EQ(longText, dest.items[1].a);
+
+    auto shared = source.shared;
+    RareMapper::map(dest, std::move(source)); // Rvalues are copied by map, only mapMove moves
+    EXPECT_EQ(longText, source.name);
+    EXPECT_EQ(longText, source.items[0].a);
+
+    RareMapper::mapMove(dest, std::move(source));
+    EXPECT_EQ(longText, dest.name);
+    ASSERT_EQ(size_t(2), dest.items.size());
+    EXPECT_EQ(longText, dest.items[0].a);
+    EXPECT_EQ(longText, dest.owned->a);
+    EXPECT_EQ(longText, dest.shared->a);
+    EXPECT_EQ(longText, dest.pair.first);
+    EXPECT_EQ(1, dest.pair.second);
+    EXPECT_EQ(longText, std::get<0>(dest.tuple).a);
+    EXPECT_EQ(2, std::get<1>(dest.tuple));
+    EXPECT_EQ(longText, dest.first);
+
+    EXPECT_TRUE(source.name.empty());
+    EXPECT_TRUE(source.items[0].a.empty());
+    EXPECT_TRUE(source.owned->a.empty());
+    EXPECT_EQ(longText, shared->a); // Shared pointees are copied
+    EXPECT_TRUE(source.pair.first.empty());
+    EXPECT_TRUE(std::get<0>(source.tuple).a.empty());
+
+    Dest returned = RareMapper::mapMove<Dest>(makeSource());
+    EXPECT_EQ(longText, returned.items[1].a);
+    EXPECT_EQ(longText, returned.owned->a);
+
+    std::vector<Source_string> sourceItems { Source_string{longText} };
+    auto destItems = RareMapper::mapMove<std::vector<Dest_string>>(std::move(sourceItems));
+    ASSERT_EQ(size_t(1), destItems.size());
+    EXPECT_EQ(longText, destItems[0].a);
+    EXPECT_TRUE(sourceItems[0].a.empty());
+
+    Noted_Source notedSource { longText, { 1, 2, 3 } };
+    Noted_Dest notedDest {};
+    RareMapper::mapMove(notedDest, std::move(notedSource));
+    EXPECT_EQ(longText, notedDest.a); // x is mapped to both a and b so is copied
+    EXPECT_EQ(longText, notedDest.b);
+    EXPECT_EQ(size_t(3), notedDest.c.size());
+    EXPECT_EQ(longText, notedSource.x);
+    EXPECT_TRUE(notedSource.y.empty());
+
+    auto ownedInt = std::make_unique<int>(1);
+    int* ownedAddress = ownedInt.get();
+    std::unique_ptr<int> destInt {};
+    RareMapper::mapMove(destInt, std::move(ownedInt)); // Move-only types are move-assigned
+    EXPECT_EQ(ownedAddress, destInt.get());
+    EXPECT_EQ(nullptr, ownedInt);
+
+    Unreflected::SpecString specString { "0" };
+    RareMapper::mapMove(specString, Unreflected::SpecInt { 5 }); // Specializations are used when no move-mapping applies
+    EXPECT_STREQ("6", specString.a.c_str());
+
+    Secret secret { longText };
+    Redacted redacted {};
+    RareMapper::mapMove(redacted, std::move(secret)); // Marked specializations are used ahead of move-mappings
+    EXPECT_STREQ("***", redacted.a.c_str());
+    EXPECT_EQ(longText, secret.a);
+
+    auto redactedItems = RareMapper::mapMove<std::vector<Redacted>>(std::vector<Secret>{ Secret{longText} });
+    ASSERT_EQ(size_t(1), redactedItems.size());
+    EXPECT_STREQ("***", redactedItems[0].a.c_str());
+
+    Masked masked {};
+    RareMapper::map(masked, Secret{longText}); // Unmarked specializations run for rvalues passed to map
+    EXPECT_STREQ("###", masked.a.c_str());
+    auto maskedItems = RareMapper::map<std::vector<Masked>>(std::vector<Secret>{ Secret{longText} });
+    ASSERT_EQ(size_t(1), maskedItems.size());
+    EXPECT_STREQ("###", maskedItems[0].a.c_str());
+}
+
+namespace BulkMapped
+{
+    struct Wire {
+        int id;
+        float x;
+        float y;
+        REFLECT(Wire, id, x, y)
+    };
+    struct Domain {
+        int id;
+        float x;
+        float y;
+        REFLECT(Domain, id, x, y)
+    };
+    struct Reordered {
+        int id;
+        float y;
+        float x;
+        REFLECT(Reordered, id, y, x)
+    };
+    struct Tagged {
+        int id = 0;
+        std::vector<int> values {};
+        int tag = 7;
+        REFLECT(Tagged, id, values, tag)
+    };
+    struct Untagged {
+        int id = 0;
+        std::vector<int> values {};
+        REFLECT(Untagged, id, values)
+    };
+    struct Versioned {
+        const int version = 1;
+        int id = 0;
+        REFLECT(Versioned, version, id)
+    };
+    struct Celsius {
+        float degrees;
+        REFLECT(Celsius, degrees)
+    };
+    struct Fahrenheit {
+        float degrees;
+        REFLECT(Fahrenheit, degrees)
+    };
+}
+
+template <> struct RareMapper::IsLayoutMapped<BulkMapped::Domain, BulkMapped::Wire> : std::true_type {};
+template <> struct RareMapper::IsLayoutMapped<BulkMapped::Reordered, BulkMapped::Wire> : std::true_type {};
+
+template <> void RareMapper::map(BulkMapped::Fahrenheit & fahrenheit, const BulkMapped::Celsius & celsius)
+{
+    fahrenheit.degrees = celsius.degrees*9.f/5.f + 32.f;
+}
+
+TEST(RareMapperTest, MapContainersInBulk)
+{
+    using namespace BulkMapped;
+    static_assert(RareMapper::detail::isLayoutIdentical<Domain, Wire>());
+    static_assert(RareMapper::detail::isLayoutIdentical<int, const int>());
+    static_assert(!RareMapper::detail::isLayoutIdentical<Reordered, Wire>());
+    static_assert(!RareMapper::detail::isLayoutIdentical<float, int>());
+    static_assert(!RareMapper::detail::isLayoutIdentical<Wire, Domain>()); // Not opted in
+    static_assert(!RareMapper::detail::isLayoutIdentical<Reflected::Dest_intA, Reflected::Source_intA>());
+    static_assert(!RareMapper::detail::isLayoutIdentical<MoveMapped::Dest_string, MoveMapped::Source_string>()); // Not trivially copyable
+
+    std::vector<Wire> wire { {1, 2.f, 3.f}, {4, 5.f, 6.f} };
+    auto domain = RareMapper::map<std::vector<Domain>>(wire); // Copied with memcpy
+    ASSERT_EQ(size_t(2), domain.size());
+    EXPECT_EQ(4, domain[1].id);
+    EXPECT_EQ(5.f, domain[1].x);
+    EXPECT_EQ(6.f, domain[1].y);
+
+    auto reordered = RareMapper::map<std::vector<Reordered>>(wire); // Mapped by member name
+    ASSERT_EQ(size_t(2), reordered.size());
+    EXPECT_EQ(2.f, reordered[0].x);
+    EXPECT_EQ(3.f, reordered[0].y);
+
+    wire.clear();
+    RareMapper::map(domain, wire);
+    EXPECT_TRUE(domain.empty());
+
+    std::vector<Tagged> tagged(2, Tagged{1, std::vector<int>(1000, 1), 99});
+    auto reusedCapacity = tagged[0].values.capacity();
+    std::vector<Untagged> untagged { {5, {2, 3}} };
+    RareMapper::map(tagged, untagged); // Existing elements are reused
+    ASSERT_EQ(size_t(1), tagged.size());
+    EXPECT_EQ(5, tagged[0].id);
+    EXPECT_EQ((std::vector<int>{2, 3}), tagged[0].values);
+    EXPECT_EQ(reusedCapacity, tagged[0].values.capacity()); // Mapped in place, the vector's storage is kept
+    EXPECT_EQ(7, tagged[0].tag); // The unmapped member is reset rather than keeping its prior value
+
+    auto versioned = RareMapper::map<std::vector<Versioned>>(std::vector<Wire>{ {2, 0.f, 0.f}, {3, 0.f, 0.f} }); // Not move-assignable
+    ASSERT_EQ(size_t(2), versioned.size());
+    EXPECT_EQ(1, versioned[1].version);
+    EXPECT_EQ(3, versioned[1].id);
+
+    static_assert(!RareMapper::detail::isLayoutIdentical<Fahrenheit, Celsius>()); // Not opted in, so the specialization is used
+    std::vector<Celsius> celsius { {0.f}, {100.f} };
+    auto fahrenheit = RareMapper::map<std::vector<Fahrenheit>>(celsius);
+    ASSERT_EQ(size_t(2), fahrenheit.size());
+    EXPECT_EQ(32.f, fahrenheit[0].degrees);
+    EXPECT_EQ(212.f, fahrenheit[1].degrees);
+
+    std::set<int> set {};
+    RareMapper::map(set, std::vector<int>{3, 1, 2, 1});
+    EXPECT_EQ(size_t(3), set.size());
+    EXPECT_EQ(1, *set.begin());
+}
+
 TEST(RareMapperAnnotationsTest, MappedByAnnotation)
 {
     auto mappedByNote = RareMapper::MappedBy<int>;
@@ -0,0 +1,121 @@
+#include <rarecpp/parallel_map.h>
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ParallelMapTest
+{
+    struct Wire
+    {
+        int id;
+        std::string name;
+
+        REFLECT(Wire, id, name)
+    };
+
+    struct Domain
+    {
+        long long id = 0;
+        std::string name;
+
+        REFLECT(Domain, id, name)
+    };
+
+    struct Labeled
+    {
+        long long id = 0;
+        std::string name;
+        int label = 7;
+
+        REFLECT(Labeled, id, name, label)
+    };
+
+    struct Throwing
+    {
+        int id = 0;
+
+        void map_from(const Wire & wire)
+        {
+            if ( wire.id == 3000 )
+                throw std::runtime_error("bad record");
+
+            id = wire.id;
+        }
+    };
+
+    std::vector<Wire> makeWire(size_t size)
+    {
+        std::vector<Wire> wire(size);
+        for ( size_t i=0; i<size; ++i )
+            wire[i] = Wire{int(i), "a name long enough to be heap allocated " + std::to_string(i)};
+
+        return wire;
+    }
+}
+
+using namespace ParallelMapTest;
+
+TEST(ParallelMapTest, MapChunks)
+{
+    auto wire = makeWire(10000);
+    std::vector<Domain> domain(3); // Pre-existing elements are resized away
+    RareMapper::map(RareMapper::Parallel{4, 1000}, domain, wire);
+    ASSERT_EQ(size_t(10000), domain.size());
+    for ( size_t i=0; i<domain.size(); ++i )
+    {
+        EXPECT_EQ((long long)i, domain[i].id);
+        EXPECT_EQ(wire[i].name, domain[i].name);
+    }
+
+    auto deque = RareMapper::mapMove<std::deque<Domain>>(RareMapper::Parallel{3, 100}, std::move(wire));
+    ASSERT_EQ(size_t(10000), deque.size());
+    EXPECT_EQ(9999, deque.back().id);
+    EXPECT_EQ(domain[5000].name, deque[5000].name);
+    EXPECT_TRUE(wire[5000].name.empty()); // Elements of rvalue sources are moved
+
+    std::vector<Domain> oddSize {};
+    RareMapper::map(RareMapper::Parallel{3, 1}, oddSize, makeWire(7));
+    ASSERT_EQ(size_t(7), oddSize.size());
+    EXPECT_EQ(6, oddSize[6].id);
+
+    std::vector<Labeled> labeled(2000, Labeled{1, "", 99}); // Members of reused elements with no counterpart in Domain are reset
+    RareMapper::map(RareMapper::Parallel{4, 100}, labeled, domain);
+    ASSERT_EQ(size_t(10000), labeled.size());
+    EXPECT_EQ(7, labeled[0].label);
+    EXPECT_EQ(7, labeled[1999].label);
+    EXPECT_EQ(7, labeled[9999].label);
+    EXPECT_EQ(1999, labeled[1999].id);
+
+    std::vector<Domain> fewerChunks {}; // Chunks of two leave only three threads with work
+    RareMapper::map(RareMapper::Parallel{4, 0}, fewerChunks, makeWire(5));
+    ASSERT_EQ(size_t(5), fewerChunks.size());
+    EXPECT_EQ(4, fewerChunks[4].id);
+}
+
+TEST(ParallelMapTest, SequentialFallback)
+{
+    auto wire = makeWire(10);
+    auto domain = RareMapper::map<std::vector<Domain>>(RareMapper::parallel, wire); // Below threshold
+    ASSERT_EQ(size_t(10), domain.size());
+    EXPECT_EQ(9, domain[9].id);
+
+    std::list<Domain> list {}; // Not random-access
+    RareMapper::map(RareMapper::Parallel{4, 1}, list, wire);
+    ASSERT_EQ(size_t(10), list.size());
+    EXPECT_EQ(wire[9].name, list.back().name);
+
+    std::vector<int> ints(5000, 1);
+    auto copied = RareMapper::map<std::vector<int>>(RareMapper::Parallel{4, 1}, ints);
+    EXPECT_EQ(ints, copied);
+}
+
+TEST(ParallelMapTest, Exceptions)
+{
+    auto wire = makeWire(5000);
+    std::vector<Throwing> throwing {};
+    EXPECT_THROW(RareMapper::map(RareMapper::Parallel{4, 1}, throwing, wire), std::runtime_error);
+}
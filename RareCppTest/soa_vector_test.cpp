@@ -0,0 +1,104 @@
+#include <rarecpp/soa_vector.h>
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace SoaVectorTest
+{
+    struct Entity
+    {
+        float x = 0.f;
+        float y = 0.f;
+        bool alive = false;
+        std::string name;
+        std::vector<int> tags;
+
+        static int staticValue;
+        int method() { return 0; }
+
+        REFLECT(Entity, x, y, alive, name, tags, staticValue, method)
+    };
+
+    int Entity::staticValue = 0;
+}
+
+using namespace SoaVectorTest;
+
+TEST(SoaVectorTest, PushAndAccess)
+{
+    RareTs::soa_vector<Entity> entities;
+    EXPECT_TRUE(entities.empty());
+
+    entities.push_back(Entity{1.f, 2.f, true, "first", {1, 2}});
+    Entity second {3.f, 4.f, false, "second", {3}};
+    entities.push_back(std::move(second));
+    ASSERT_EQ(size_t(2), entities.size());
+
+    EXPECT_EQ(1.f, entities[0].x);
+    EXPECT_EQ(4.f, entities[1].y);
+    EXPECT_TRUE(entities[0].alive);
+    EXPECT_EQ("second", entities[1].name);
+    EXPECT_EQ(size_t(2), entities[0].tags.size());
+
+    entities[0].x += 10.f;
+    entities[1].alive = true;
+    EXPECT_EQ(11.f, entities.columns().x[0]);
+    EXPECT_TRUE(entities.columns().alive[1].value);
+
+    Entity copy = entities[1];
+    EXPECT_EQ(3.f, copy.x);
+    EXPECT_TRUE(copy.alive);
+    EXPECT_EQ("second", copy.name);
+
+    entities[0] = entities[1];
+    EXPECT_EQ(3.f, entities[0].x);
+    EXPECT_EQ("second", entities[0].name);
+
+    entities[1] = Entity{5.f, 6.f, false, "third", {}};
+    EXPECT_EQ(6.f, entities.back().y);
+    EXPECT_EQ("third", entities.back().name);
+
+    const auto & constEntities = entities;
+    EXPECT_EQ(3.f, constEntities.front().x);
+    bool isConstRef = std::is_const_v<std::remove_reference_t<decltype(constEntities[0].x)>>;
+    EXPECT_TRUE(isConstRef);
+    EXPECT_THROW(constEntities.at(2), std::out_of_range);
+
+    entities.pop_back();
+    EXPECT_EQ(size_t(1), entities.size());
+    EXPECT_EQ(size_t(1), entities.columns().name.size());
+    entities.clear();
+    EXPECT_TRUE(entities.empty());
+    EXPECT_TRUE(entities.columns().tags.empty());
+}
+
+TEST(SoaVectorTest, Columns)
+{
+    RareTs::soa_vector<Entity> entities;
+    entities.resize(4);
+    EXPECT_EQ(size_t(4), entities.columns().y.size());
+
+    float x = 0.f;
+    for ( auto entity : entities )
+        entity.x = x++;
+
+    EXPECT_EQ(3.f, entities[3].x);
+
+    auto xs = entities.column<RareTs::IndexOf<Entity>::x>();
+    EXPECT_EQ(size_t(4), xs.size());
+    for ( float & value : xs )
+        value *= 2.f;
+
+    EXPECT_EQ(6.f, entities[3].x);
+
+    size_t totalColumns = 0;
+    RareTs::Members<Entity>::forEach<RareTs::Filter::IsInstanceData>([&](auto member) {
+        auto column = entities.column(member);
+        EXPECT_EQ(entities.size(), column.size());
+        ++totalColumns;
+    });
+    EXPECT_EQ(size_t(5), totalColumns);
+}
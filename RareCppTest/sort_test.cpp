@@ -0,0 +1,104 @@
+#include <rarecpp/sort.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SortTest
+{
+    enum class Side : std::uint8_t { Buy, Sell };
+
+    struct Trade
+    {
+        int day = 0;
+        double price = 0.0;
+        Side side = Side::Buy;
+        std::int64_t id = 0;
+        std::string venue {};
+
+        REFLECT(Trade, day, price, side, id, venue)
+    };
+
+    std::vector<Trade> makeTrades(std::size_t total)
+    {
+        std::vector<Trade> trades {};
+        std::uint32_t seed = 12345;
+        auto next = [&]() { seed = seed * 1103515245u + 12345u; return seed >> 8; };
+        for ( std::size_t i=0; i<total; ++i )
+        {
+            trades.push_back(Trade{int(next() % 64) - 32, double(int(next() % 200) - 100) / 8.0,
+                next() % 2 == 0 ? Side::Buy : Side::Sell, std::int64_t(i), std::string(1, char('a' + next() % 4))});
+        }
+        return trades;
+    }
+}
+
+using namespace SortTest;
+
+TEST(SortTest, Comparator)
+{
+    RareTs::comparator<Trade, &Trade::day, &Trade::price> byDayPrice {};
+    EXPECT_TRUE(byDayPrice(Trade{1, 5.0}, Trade{2, 1.0}));
+    EXPECT_TRUE(byDayPrice(Trade{1, 1.0}, Trade{1, 5.0}));
+    EXPECT_FALSE(byDayPrice(Trade{1, 5.0}, Trade{1, 5.0, Side::Sell}));
+    EXPECT_TRUE(decltype(byDayPrice)::radixable);
+    EXPECT_FALSE((RareTs::comparator<Trade, &Trade::day, &Trade::venue>::radixable));
+
+    RareTs::comparator<Trade> allMembers {}; // Compares reflected members in declaration order
+    EXPECT_TRUE(allMembers(Trade{1, 1.0, Side::Sell, 2, "b"}, Trade{1, 1.0, Side::Sell, 2, "c"}));
+    EXPECT_FALSE(allMembers(Trade{1, 1.0, Side::Sell, 3, "a"}, Trade{1, 1.0, Side::Sell, 2, "c"}));
+    EXPECT_FALSE(decltype(allMembers)::radixable);
+}
+
+TEST(SortTest, SortBySmall)
+{
+    std::vector<Trade> trades { {2, 1.5, Side::Buy, 0}, {1, -2.0, Side::Sell, 1}, {2, -0.5, Side::Buy, 2}, {1, -2.0, Side::Buy, 3} };
+    RareTs::sort_by<&Trade::day, &Trade::price>(trades);
+    std::vector<std::int64_t> ids {};
+    for ( const auto & trade : trades )
+        ids.push_back(trade.id);
+
+    EXPECT_EQ((std::vector<std::int64_t>{1, 3, 2, 0}), ids);
+
+    RareTs::sort_by_desc<&Trade::side>(trades);
+    ids.clear();
+    for ( const auto & trade : trades )
+        ids.push_back(trade.id);
+
+    EXPECT_EQ((std::vector<std::int64_t>{1, 3, 2, 0}), ids); // Stable, Sells first then Buys in their prior order
+}
+
+TEST(SortTest, SortByRadixMatchesStableSort)
+{
+    auto trades = makeTrades(RareTs::radixSortThreshold * 3);
+    auto expected = trades;
+    RareTs::sort_by<&Trade::price, &Trade::side, &Trade::day>(trades);
+    std::stable_sort(expected.begin(), expected.end(), RareTs::comparator<Trade, &Trade::price, &Trade::side, &Trade::day>{});
+    for ( std::size_t i=0; i<trades.size(); ++i )
+        EXPECT_EQ(expected[i].id, trades[i].id);
+
+    expected = trades;
+    RareTs::sort_by_desc<&Trade::day>(trades);
+    std::stable_sort(expected.begin(), expected.end(), [](const Trade & l, const Trade & r) { return r.day < l.day; });
+    for ( std::size_t i=0; i<trades.size(); ++i )
+        EXPECT_EQ(expected[i].id, trades[i].id);
+}
+
+TEST(SortTest, TrackedSortBy)
+{
+    auto trades = makeTrades(RareTs::radixSortThreshold + 5);
+    auto original = trades;
+    auto sourceIndexes = RareTs::tracked_sort_by<false, std::uint32_t>(trades, RareTs::comparator<Trade, &Trade::day, &Trade::id>{});
+    ASSERT_EQ(trades.size(), sourceIndexes.size());
+    for ( std::size_t i=0; i<trades.size(); ++i )
+        EXPECT_EQ(original[sourceIndexes[i]].id, trades[i].id);
+
+    EXPECT_TRUE(std::is_sorted(trades.begin(), trades.end(), RareTs::comparator<Trade, &Trade::day, &Trade::id>{}));
+
+    std::vector<double> values { 0.0, -1.5, 3.25, -0.0, -8.0, 2.0 };
+    auto valueIndexes = RareTs::tracked_sort_by<true>(values, std::less<>{});
+    EXPECT_EQ((std::vector<double>{3.25, 2.0, 0.0, -0.0, -1.5, -8.0}), values);
+    EXPECT_EQ((std::vector<std::size_t>{2, 5, 0, 3, 1, 4}), valueIndexes);
+}
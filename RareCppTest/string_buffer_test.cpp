@@ -1,7 +1,15 @@
 #include <rarecpp/string_buffer.h>
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cstddef>
+#include <cstdio>
+#include <cstring>
 #include <istream>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -652,6 +660,354 @@ TEST(StringBufferTest, SourceBackedRead)
     EXPECT_STREQ("asdfqwertypoiuy", sb.str().c_str());
 }
 
+TEST(StringBufferTest, WindowedSourceRead)
+{
+    std::string text;
+    for ( size_t i=0; i<1000; ++i )
+        text += char('a' + i%26);
+
+    std::stringstream src(text);
+    IStringBuffer sb(src, 64, 4);
+    std::istream & is = (std::istream &)sb;
+
+    std::string read;
+    char c = '\0';
+    size_t maxSize = 0;
+    while ( is.get(c) )
+    {
+        read += c;
+        maxSize = std::max(maxSize, sb.size());
+        if ( read.size() % 50 == 0 ) // Unget across window boundaries
+        {
+            is.unget();
+            is.unget();
+            EXPECT_TRUE(is.good());
+            EXPECT_EQ(read.size()-2, size_t(is.tellg()));
+            is.get(c);
+            is.get(c);
+            EXPECT_EQ(read.back(), c);
+        }
+    }
+    EXPECT_STREQ(text.c_str(), read.c_str());
+    EXPECT_LE(maxSize, size_t(64+4));
+    EXPECT_EQ(text.size()-sb.size(), sb.discardedSize());
+    const std::vector<char> & window = sb.vec(); // Only the chars of the window, not the unused space reserved for refills
+    EXPECT_EQ(sb.size(), window.size());
+    EXPECT_EQ(text.substr(sb.discardedSize()), std::string(window.begin(), window.end()));
+    EXPECT_EQ(text.substr(sb.discardedSize()), sb.str());
+
+    std::stringstream emptySrc;
+    IStringBuffer emptySb(emptySrc, 16);
+    EXPECT_FALSE(((std::istream &)emptySb).get(c));
+}
+
+TEST(StringBufferTest, WindowedSourceEnd)
+{
+    struct CountingSource : std::stringbuf
+    {
+        using std::stringbuf::stringbuf;
+        size_t reads = 0;
+        std::streamsize xsgetn(char* s, std::streamsize n) override { ++reads; return std::stringbuf::xsgetn(s, n); }
+    };
+    CountingSource counting(std::string(100, 'x'));
+    std::istream src(&counting);
+    IStringBuffer sb(src, 64);
+    std::istream & is = (std::istream &)sb;
+
+    char c = '\0';
+    is.get(c);
+    EXPECT_EQ(std::streampos(-1), is.rdbuf()->pubseekoff(0, std::ios_base::end, std::ios_base::in)); // End of source not yet known
+    EXPECT_TRUE(is.good());
+
+    size_t total = 1;
+    while ( is.get(c) )
+        ++total;
+
+    EXPECT_EQ(size_t(100), total);
+    size_t reads = counting.reads;
+    is.clear();
+    EXPECT_FALSE(is.get(c));
+    EXPECT_FALSE(is.get(c));
+    EXPECT_EQ(reads, counting.reads); // The exhausted source isn't polled again
+    is.clear();
+    EXPECT_EQ(std::streampos(100), is.rdbuf()->pubseekoff(0, std::ios_base::end, std::ios_base::in));
+}
+
+TEST(StringBufferTest, ViewStringBuffer)
+{
+    std::string text = "qwerty";
+    ViewStringBuffer sb(text);
+    std::istream & is = (std::istream &)sb;
+    EXPECT_EQ(text.data(), sb.view().data());
+    EXPECT_EQ(size_t(6), sb.size());
+
+    char c = '\0';
+    is >> c;
+    EXPECT_EQ('q', c);
+    is >> c;
+    EXPECT_EQ('w', c);
+    EXPECT_STREQ("erty", std::string(sb.remaining()).c_str());
+
+    is.unget();
+    is >> c;
+    EXPECT_EQ('w', c);
+
+    is.seekg(4);
+    is >> c;
+    EXPECT_EQ('t', c);
+    EXPECT_EQ(5, is.tellg());
+
+    is >> c;
+    EXPECT_FALSE(is >> c);
+    EXPECT_TRUE(sb.remaining().empty());
+
+    sb.reset("asdf");
+    is >> c;
+    EXPECT_EQ('a', c);
+}
+
+TEST(StringBufferTest, ChunkedOutput)
+{
+    StringBuffer sb;
+    sb.enableChunks(16);
+    EXPECT_TRUE(sb.chunked());
+
+    std::string expected;
+    sb << "0123456789";
+    expected += "0123456789";
+    const char* first = sb.spans()[0].data();
+    for ( int i=0; i<100; ++i )
+    {
+        sb << "abc" << i << ' ';
+        (std::ostream &)sb << 'x';
+        expected += "abc" + std::to_string(i) + " x";
+    }
+    sb << std::string(40, 'z'); // Larger than a chunk
+    expected += std::string(40, 'z');
+
+    std::vector<std::string_view> spans = sb.spans();
+    EXPECT_GT(spans.size(), size_t(10));
+    EXPECT_EQ(first, spans[0].data()); // Written chars never move
+    for ( const auto & span : spans )
+        EXPECT_LE(span.size(), size_t(16)); // Including the oversized append, which is split across chunks
+
+    EXPECT_EQ(expected.size(), sb.totalSize());
+    EXPECT_EQ(expected.size(), sb.size());
+    EXPECT_STREQ(expected.c_str(), sb.str().c_str());
+    for ( size_t i=0; i<expected.size(); ++i )
+        EXPECT_EQ(expected[i], sb[i]);
+
+    EXPECT_THROW(sb.vec(), std::logic_error); // Output is no longer contiguous
+    EXPECT_THROW(sb.c_str(), std::logic_error);
+
+    std::stringstream ss;
+    ss << sb;
+    EXPECT_STREQ(expected.c_str(), ss.str().c_str());
+
+    std::stringstream written;
+    sb.writeTo(written);
+    EXPECT_STREQ(expected.c_str(), written.str().c_str());
+    EXPECT_EQ(size_t(0), sb.totalSize());
+
+#ifdef RARE_HAS_WRITEV
+    for ( int i=0; i<50; ++i )
+        sb << "line " << i << sb.endl;
+    std::string lines = sb.str();
+
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(nullptr, file);
+    EXPECT_TRUE(sb.writeTo(fileno(file)));
+    EXPECT_EQ(size_t(0), sb.totalSize());
+
+    std::string readBack(lines.size(), '\0');
+    std::rewind(file);
+    EXPECT_EQ(lines.size(), std::fread(&readBack[0], 1, readBack.size(), file));
+    EXPECT_STREQ(lines.c_str(), readBack.c_str());
+    std::fclose(file);
+#endif
+}
+
+TEST(StringBufferTest, SinkOutput)
+{
+    std::stringstream sink;
+    std::string expected;
+    {
+        OStringBuffer sb;
+        sb.attachSink(sink, 32);
+        EXPECT_TRUE(sb.sinkAttached());
+        for ( int i=0; i<100; ++i )
+        {
+            sb << "item " << i << ',';
+            expected += "item " + std::to_string(i) + ",";
+            EXPECT_LE(sb.size(), size_t(32));
+        }
+        EXPECT_GT(sink.str().size(), size_t(0)); // Output reaches the sink before the buffer is flushed
+        EXPECT_LT(sink.str().size(), expected.size());
+
+        sb << std::string(100, 'q'); // Larger than the high-water mark
+        expected += std::string(100, 'q');
+        EXPECT_LE(sb.size(), size_t(32));
+
+        sb.flushSink();
+        EXPECT_STREQ(expected.c_str(), sink.str().c_str());
+        EXPECT_EQ(size_t(0), sb.size());
+
+        sb << "end";
+        expected += "end";
+    } // Destruction writes the remaining output
+    EXPECT_STREQ(expected.c_str(), sink.str().c_str());
+
+    std::stringstream ptrSink;
+    [](OStringBufferPtr osb) { *osb << "b"; }((std::ostream &)ptrSink);
+    EXPECT_STREQ("b", ptrSink.str().c_str());
+
+    {
+        std::stringstream smallSink;
+        StringBuffer sb;
+        sb.enableChunks(64);
+        sb.attachSink(smallSink);
+        sb << "small";
+        EXPECT_LT(sb.vec().capacity(), size_t(1024)); // The high-water mark is not reserved up front
+        sb.detachSink();
+        EXPECT_STREQ("small", smallSink.str().c_str());
+        EXPECT_TRUE(sb.chunked()); // Chunked output resumes once the sink is detached
+    }
+
+    {
+        struct SyncCounter : std::stringbuf
+        {
+            size_t syncs = 0;
+            int sync() override { ++syncs; return std::stringbuf::sync(); }
+        };
+        SyncCounter counter;
+        std::ostream counted(&counter);
+        OStringBuffer sb;
+        sb.attachSink(counted, 8);
+        for ( int i=0; i<10; ++i )
+            sb << "0123456789";
+        EXPECT_EQ(size_t(0), counter.syncs); // Reaching the high-water mark writes to the sink without flushing it
+        sb.detachSink();
+        EXPECT_EQ(size_t(1), counter.syncs);
+        EXPECT_EQ(size_t(100), counter.str().size());
+    }
+
+    {
+        std::ostream failing(nullptr); // Writes fail and set badbit
+        OStringBuffer sb;
+        sb.attachSink(failing, 8);
+        sb << "0123456789";
+        sb.detachSink();
+        EXPECT_TRUE(sb.bad());
+        EXPECT_EQ(size_t(0), sb.sinkWritten()); // Failed writes aren't counted
+    }
+
+#ifdef RARE_HAS_WRITEV
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(nullptr, file);
+    {
+        StringBuffer sb;
+        sb.attachSink(fileno(file), 16);
+        for ( int i=0; i<20; ++i )
+            sb << "0123456789";
+        sb.detachSink();
+        EXPECT_FALSE(sb.sinkAttached());
+    }
+    std::string readBack(200, '\0');
+    std::rewind(file);
+    EXPECT_EQ(size_t(200), std::fread(&readBack[0], 1, readBack.size(), file));
+    EXPECT_EQ('0', readBack[0]);
+    EXPECT_EQ('9', readBack[199]);
+    std::fclose(file);
+#endif
+}
+
+TEST(StringBufferTest, MemorySinks)
+{
+    StringBuffer sb;
+    sb.attachCountingSink(16);
+    for ( int i=0; i<20; ++i )
+    {
+        sb << "0123456789";
+        EXPECT_LE(sb.size(), size_t(16));
+    }
+    sb.detachSink();
+    EXPECT_EQ(size_t(200), sb.sinkWritten());
+    EXPECT_EQ(size_t(0), sb.size());
+
+    char output[24] {};
+    sb.attachSink(output, 20, 8);
+    sb << "abcdefghij" << 1234567890;
+    sb.detachSink();
+    EXPECT_FALSE(sb.bad());
+    EXPECT_EQ(size_t(20), sb.sinkWritten());
+    EXPECT_STREQ("abcdefghij1234567890", output);
+
+    sb.attachSink(output, 4, 8);
+    sb << "too long";
+    sb.detachSink();
+    EXPECT_TRUE(sb.bad()); // Output beyond the span's capacity is discarded and fails the stream
+    EXPECT_EQ(size_t(8), sb.sinkWritten());
+    EXPECT_EQ('t', output[0]);
+    EXPECT_EQ('e', output[4]); // Unchanged from the prior output
+}
+
+TEST(StringBufferTest, RawAppend)
+{
+    StringBuffer sb;
+    sb << "a";
+    char* out = sb.reserveRaw(3);
+    out[0] = 'b';
+    out[1] = 'c';
+    sb.commitRaw(2);
+    EXPECT_STREQ("abc", sb.str().c_str());
+
+    out = sb.reserveRaw(1000);
+    EXPECT_EQ(size_t(3), sb.size()); // Reserved chars are kept apart from the buffer until committed
+    std::memset(out, 'd', 1000);
+    sb.commitRaw(500);
+    EXPECT_EQ(size_t(503), sb.size());
+    EXPECT_EQ('d', sb[502]);
+    EXPECT_EQ(out, sb.reserveRaw(1000)); // The reserved chars are reused rather than reallocated
+    sb.commitRaw(0);
+    EXPECT_EQ(size_t(503), sb.size());
+
+    sb.clear();
+    sb.enableChunks(8);
+    sb << "0123456";
+    out = sb.reserveRaw(4); // Would overflow the chunk, so a new chunk is started before the raw chars are written
+    std::memcpy(out, "789", 3);
+    sb.commitRaw(3);
+    EXPECT_EQ(size_t(2), sb.spans().size());
+    EXPECT_STREQ("0123456789", sb.str().c_str());
+
+    StringBuffer numbers;
+    numbers << std::numeric_limits<long long>::min() << ' ' << std::numeric_limits<unsigned long long>::max() << ' ' << true;
+    EXPECT_STREQ("-9223372036854775808 18446744073709551615 1", numbers.str().c_str());
+}
+
+TEST(StringBufferTest, PmrStringBuffer)
+{
+    char arena[1024] {};
+    std::pmr::monotonic_buffer_resource resource(arena, sizeof(arena), std::pmr::null_memory_resource());
+    {
+        RareBufferedStream::pmr::StringBuffer sb(&resource);
+        sb << "asdf" << 1234 << ' ' << "x";
+        EXPECT_STREQ("asdf1234 x", sb.str().c_str());
+        EXPECT_EQ(&resource, sb.vec().get_allocator().resource());
+
+        RareBufferedStream::pmr::StringBuffer other(std::string("qwer"), &resource);
+        sb.swap(other);
+        EXPECT_STREQ("qwer", sb.str().c_str());
+        EXPECT_STREQ("asdf1234 x", other.str().c_str());
+    }
+    EXPECT_THROW(RareBufferedStream::pmr::StringBuffer(std::string(sizeof(arena), 'a'), &resource), std::bad_alloc);
+
+    char rawArena[64] {};
+    std::pmr::monotonic_buffer_resource rawResource(rawArena, sizeof(rawArena), std::pmr::null_memory_resource());
+    RareBufferedStream::pmr::StringBuffer raw(&rawResource);
+    EXPECT_THROW(raw.reserveRaw(sizeof(rawArena)+1), std::bad_alloc); // Raw chars are allocated from the resource as well
+}
+
 TEST(StringBufferTest, Example)
 {
     StringBuffer sb;
@@ -829,6 +1185,15 @@ char iStringBufferTest(IStringBufferPtr isb)
     return c;
 }
 
+size_t iStringBufferMaxSize(IStringBufferPtr isb)
+{
+    size_t maxSize = 0;
+    char c = '\0';
+    while ( *isb >> c )
+        maxSize = std::max(maxSize, isb->size());
+    return maxSize;
+}
+
 char ioStringBufferTest(StringBufferPtr sb)
 {
     char c = '\0';
@@ -873,6 +1238,9 @@ TEST(StringBufferTest, IOStringBufferPtrCalls)
     EXPECT_EQ('h', iStringBufferTest(isb2));
     EXPECT_EQ('i', iStringBufferTest(sb2i));
 
+    std::stringstream largeIs(std::string(1024*1024, 'x'));
+    EXPECT_GT(size_t(1024*1024), iStringBufferMaxSize(largeIs)); // Streams are read a window at a time rather than all at once
+
     std::stringstream ios2("j");
     StringBuffer sb2io("l");
     EXPECT_EQ('j', ioStringBufferTest(ios2));
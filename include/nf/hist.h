@@ -21,6 +21,9 @@
 #ifndef JSON_H // This check, while normally redundant to have here, helps the file work on godbolt
 #include "../rarecpp/json.h"
 #endif
+#ifndef SORT_H // This check, while normally redundant to have here, helps the file work on godbolt
+#include "../rarecpp/sort.h"
+#endif
 
 // Nf C++: data history library
 namespace nf_hist
@@ -435,6 +438,16 @@ namespace nf_hist
         }
     }
 
+    /// Stably sorts the items using the given ordering and returns a vector of source indexes that can be used to undo the action
+    /// @param items the items to sort
+    /// @param compare the ordering, e.g. RareTs::comparator<T, &T::a, &T::b>{} (which is radix sorted on large containers)
+    /// @return a vector of source indexes
+    template <bool Desc = false, typename I = std::size_t, typename T, typename Compare>
+    [[nodiscard]] std::vector<I> tracked_sort(T & items, const Compare & compare)
+    {
+        return RareTs::tracked_sort_by<Desc, I>(items, compare);
+    }
+
     template <typename I = std::size_t, typename T>
     requires ( requires{std::declval<T>()[0] = std::declval<T>()[0];} )
     void undo_sort(T & items, const std::span<I> & source_indexes)
@@ -1192,6 +1205,12 @@ namespace nf_hist
             }
             void sort() { random_access::agent.template sort<Pathway...>((Keys &)(*this)); }
             void sort_desc() { random_access::agent.template sort_desc<Pathway...>((Keys &)(*this)); }
+            template <auto ... Members> void sort_by() {
+                random_access::agent.template sort<Pathway...>((Keys &)(*this), RareTs::comparator<T, Members...>{});
+            }
+            template <auto ... Members> void sort_by_desc() {
+                random_access::agent.template sort_desc<Pathway...>((Keys &)(*this), RareTs::comparator<T, Members...>{});
+            }
             void remove_selection() { random_access::agent.template remove_l<Pathway...>((Keys &)(*this)); }
 
             template <class U> void swap(U && first_index, U && second_index) {
@@ -2942,8 +2961,8 @@ namespace nf_hist
             });
         }
 
-        template <class ... Pathway, class Keys>
-        void sort(Keys & keys)
+        template <class ... Pathway, class Keys, class ... Compare>
+        void sort(Keys & keys, const Compare & ... compare)
         {
             event_offsets.push_back(events.size());
             events.push_back(uint8_t(op::sort));
@@ -2951,7 +2970,7 @@ namespace nf_hist
             
             operate_on<Pathway...>(t, keys, [&]<class Member, class Route>(auto & ref, type_tags<Member, Route>) {
                 using index_type = index_type_t<default_index_type, Member>;
-                auto source_indexes = tracked_sort<false, index_type>(ref);
+                auto source_indexes = tracked_sort<false, index_type>(ref, compare...);
                 if constexpr ( has_attached_data<Pathway...>() )
                     redo_sort(get_attached_data<Pathway...>(), std::span(source_indexes));
 
@@ -2984,8 +3003,8 @@ namespace nf_hist
             });
         }
 
-        template <class ... Pathway, class Keys>
-        void sort_desc(Keys & keys)
+        template <class ... Pathway, class Keys, class ... Compare>
+        void sort_desc(Keys & keys, const Compare & ... compare)
         {
             event_offsets.push_back(events.size());
             events.push_back(uint8_t(op::sort_desc));
@@ -2993,7 +3012,7 @@ namespace nf_hist
             
             operate_on<Pathway...>(t, keys, [&]<class Member, class Route>(auto & ref, type_tags<Member, Route>) {
                 using index_type = index_type_t<default_index_type, Member>;
-                auto source_indexes = tracked_sort<true, index_type>(ref);
+                auto source_indexes = tracked_sort<true, index_type>(ref, compare...);
                 if constexpr ( has_attached_data<Pathway...>() )
                     redo_sort(get_attached_data<Pathway...>(), std::span(source_indexes));
 
@@ -0,0 +1,435 @@
+// MIT License, Copyright (c) 2019-2025 Justin F https://github.com/TheNitesWhoSay/RareCpp/blob/master/LICENSE
+#ifndef BINARY_H
+#define BINARY_H
+#ifndef JSON_H
+#include "json.h"
+#endif
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// A compact reflection-driven binary format using the same annotations as Json (e.g. Json::Ignore on members and supers)
+//
+// The format is positional and not self-describing; a reader must use the same type definitions as the writer.
+// Values are written in native byte order:
+// - bool: one byte (0 or 1)
+// - other arithmetic types and enums: sizeof(T) bytes as-is
+// - pointables and optionals: one byte (0: null/empty, 1: present) followed by the pointed-to value if present
+// - pairs and tuples: each element in order
+// - static arrays: each element in order, without a length prefix
+// - contiguous containers (strings, vectors...) of arithmetic types or enums: a varint length followed by one block of the elements
+// - other iterables (including maps, sets & adaptors): a varint element count followed by each element
+// - reflected objects: the unignored instance data members in declaration order, followed by the unignored supers in order
+// Varints are unsigned LEB128 of at most maxVarintSize bytes
+namespace Binary
+{
+    using RareTs::Reflect;
+
+    inline constexpr size_t maxVarintSize = (size_t(std::numeric_limits<size_t>::digits) + 6) / 7; // 10 bytes for a 64-bit size_t
+
+    class UnexpectedInputEnd : public Json::Exception
+    {
+    public:
+        UnexpectedInputEnd() : Json::Exception("Binary input ended before a complete value was read!") {}
+    };
+
+    class VarintOverflow : public Json::Exception
+    {
+    public:
+        VarintOverflow() : Json::Exception("Binary input contained a varint too large for size_t!") {}
+    };
+
+    namespace detail
+    {
+        template <typename T> using DataOp = decltype(std::declval<T>().data());
+        template <typename T> using SizeOp = decltype(std::declval<T>().size());
+        template <typename T> using ResizeOp = decltype(std::declval<T>().resize(size_t(0)));
+
+        template <typename T> inline constexpr bool is_block_copyable_v =
+            (std::is_arithmetic_v<T> || std::is_enum_v<T>) && !std::is_same_v<bool, std::remove_cv_t<T>>;
+
+        // Static arrays (of any rank) whose elements are block copyable
+        template <typename T> inline constexpr bool is_block_static_array_v = [](){
+            if constexpr ( std::is_array_v<T> )
+                return is_block_copyable_v<std::remove_all_extents_t<T>>;
+            else if constexpr ( RareTs::is_static_array_v<T> )
+                return is_block_copyable_v<RareTs::element_type_t<T>>;
+            else
+                return false;
+        }();
+
+        // Resizable containers storing block copyable elements contiguously (e.g. std::vector<int>, std::string)
+        template <typename T> inline constexpr bool is_block_container_v = [](){
+            if constexpr ( RareTs::op_exists_v<DataOp, T> && RareTs::op_exists_v<SizeOp, T> && RareTs::op_exists_v<ResizeOp, T> )
+                return std::is_pointer_v<DataOp<T>> && is_block_copyable_v<RareTs::element_type_t<T>>;
+            else
+                return false;
+        }();
+
+        template <typename Iterable> size_t count(const Iterable & iterable)
+        {
+            if constexpr ( RareTs::op_exists_v<SizeOp, Iterable> )
+                return static_cast<size_t>(iterable.size());
+            else
+                return static_cast<size_t>(std::distance(iterable.begin(), iterable.end()));
+        }
+    }
+
+    inline namespace Output
+    {
+        inline namespace Customizers
+        {
+            template <typename Object, typename Value, size_t MemberIndex = Json::noMemberIndex>
+            struct Customize : public RareTs::Unspecialized
+            {
+                // Should return true if you put any output, else you should leave output unchanged
+                static bool as(std::string & /*output*/, const Object & /*object*/, const Value & /*value*/) { return false; }
+            };
+        }
+
+        namespace Put
+        {
+            inline void varint(std::string & os, size_t value)
+            {
+                for ( ; value >= 0x80; value >>= 7 )
+                    os.push_back(static_cast<char>(static_cast<uint8_t>(value) | uint8_t(0x80)));
+
+                os.push_back(static_cast<char>(value));
+            }
+
+            inline void bytes(std::string & os, const void* data, size_t size)
+            {
+                if ( size > 0 )
+                    os.append(static_cast<const char*>(data), size);
+            }
+
+            template <typename T> void value(std::string & os, const T & value);
+
+            template <typename Object, size_t ... Is>
+            void tuple(std::string & os, const Object & obj, std::index_sequence<Is...>)
+            {
+                (Put::value(os, std::get<Is>(obj)), ...);
+            }
+
+            template <typename Iterable>
+            void iterable(std::string & os, const Iterable & iterable)
+            {
+                if constexpr ( detail::is_block_static_array_v<Iterable> )
+                    Put::bytes(os, &iterable, sizeof(Iterable));
+                else if constexpr ( RareTs::is_static_array_v<Iterable> )
+                {
+                    for ( const auto & element : iterable )
+                        Put::value(os, element);
+                }
+                else if constexpr ( detail::is_block_container_v<Iterable> )
+                {
+                    Put::varint(os, static_cast<size_t>(iterable.size()));
+                    Put::bytes(os, iterable.data(), static_cast<size_t>(iterable.size())*sizeof(RareTs::element_type_t<Iterable>));
+                }
+                else if constexpr ( RareTs::is_adaptor_v<Iterable> )
+                    Put::iterable(os, RareTs::baseContainer(iterable));
+                else
+                {
+                    Put::varint(os, detail::count(iterable));
+                    for ( const auto & element : iterable )
+                        Put::value(os, element);
+                }
+            }
+
+            template <typename Object>
+            void fields(std::string & os, const Object & obj)
+            {
+                Reflect<Object>::Members::template forEach<Json::IsUnignoredDataMatchingStatics, Json::StaticType<Json::Statics::Excluded>>(obj,
+                    [&](auto & member, auto & value) {
+                        using Member = std::remove_reference_t<decltype(member)>;
+                        using Value = RareTs::remove_cvref_t<decltype(value)>;
+                        if constexpr ( RareTs::is_specialized_v<Customize<Object, Value, Member::index>> )
+                        {
+                            if ( Customize<Object, Value, Member::index>::as(os, obj, value) )
+                                return;
+                        }
+                        else if constexpr ( RareTs::is_specialized_v<Customize<Object, Value>> )
+                        {
+                            if ( Customize<Object, Value>::as(os, obj, value) )
+                                return;
+                        }
+                        Put::value(os, value);
+                    });
+            }
+
+            template <typename Object>
+            void object(std::string & os, const Object & obj)
+            {
+                Put::fields(os, obj);
+                Reflect<Object>::Supers::forEach(obj, [&](auto superInfo, auto & superObj) {
+                    if constexpr ( !decltype(superInfo)::template hasNote<Json::IgnoreType>() )
+                        Put::object(os, superObj);
+                });
+            }
+
+            template <typename T> void value(std::string & os, const T & value)
+            {
+                if constexpr ( std::is_same_v<bool, T> )
+                    os.push_back(value ? char(1) : char(0));
+                else if constexpr ( detail::is_block_copyable_v<T> )
+                    Put::bytes(os, &value, sizeof(T));
+                else if constexpr ( RareTs::is_optional_v<T> )
+                {
+                    os.push_back(value.has_value() ? char(1) : char(0));
+                    if ( value.has_value() )
+                        Put::value(os, *value);
+                }
+                else if constexpr ( RareTs::is_pointable_v<T> )
+                {
+                    os.push_back(value != nullptr ? char(1) : char(0));
+                    if ( value != nullptr )
+                        Put::value(os, *value);
+                }
+                else if constexpr ( RareTs::is_pair_v<T> )
+                {
+                    Put::value(os, value.first);
+                    Put::value(os, value.second);
+                }
+                else if constexpr ( RareTs::is_tuple_v<T> )
+                    Put::tuple(os, value, std::make_index_sequence<std::tuple_size_v<T>>());
+                else if constexpr ( RareTs::is_iterable_v<T> )
+                    Put::iterable(os, value);
+                else if constexpr ( RareTs::is_reflected_v<T> )
+                    Put::object(os, value);
+                else
+                    static_assert(std::is_void_v<T>, "Type is not supported by binary serialization, consider using a Binary::Customize");
+            }
+        }
+
+        // Serializes t in the binary format, replacing the contents of output
+        template <typename T>
+        inline void write(const T & t, std::string & output)
+        {
+            output.clear();
+            Put::value(output, t);
+        }
+
+        // Serializes t in the binary format
+        template <typename T>
+        inline std::string write(const T & t)
+        {
+            std::string output {};
+            Put::value(output, t);
+            return output;
+        }
+    }
+
+    inline namespace Input
+    {
+        // A read position within caller-owned binary input
+        class Source
+        {
+        public:
+            Source(std::string_view input) : pos(input.data()), end(input.data()+input.size()) {}
+
+            size_t remaining() const { return static_cast<size_t>(end - pos); }
+
+            void get(void* dest, size_t size)
+            {
+                if ( size > remaining() )
+                    throw UnexpectedInputEnd();
+                else if ( size > 0 )
+                {
+                    std::memcpy(dest, pos, size);
+                    pos += size;
+                }
+            }
+
+            uint8_t byte()
+            {
+                if ( pos == end )
+                    throw UnexpectedInputEnd();
+
+                return static_cast<uint8_t>(*pos++);
+            }
+
+            size_t varint() // Reads at most maxVarintSize bytes, throws VarintOverflow if the value doesn't fit in a size_t
+            {
+                constexpr size_t digits = size_t(std::numeric_limits<size_t>::digits);
+                size_t value = 0;
+                for ( size_t shift = 0; shift < digits; shift += 7 )
+                {
+                    uint8_t curr = byte();
+                    size_t bits = size_t(curr & uint8_t(0x7F));
+                    if ( digits - shift < 7 && (bits >> (digits - shift)) != 0 )
+                        throw VarintOverflow();
+
+                    value |= bits << shift;
+                    if ( (curr & uint8_t(0x80)) == 0 )
+                        return value;
+                }
+                throw VarintOverflow();
+            }
+
+        private:
+            const char* pos;
+            const char* end;
+        };
+
+        inline namespace Customizers
+        {
+            template <typename Object, typename Value, size_t MemberIndex = Json::noMemberIndex>
+            struct Customize : public RareTs::Unspecialized
+            {
+                // Should return true if you read the value, else you should leave input unchanged
+                static bool as(Source & /*input*/, Object & /*object*/, Value & /*value*/) { return false; }
+            };
+        }
+
+        namespace Read
+        {
+            template <typename T> void value(Source & is, T & value);
+
+            template <typename Object, size_t ... Is>
+            void tuple(Source & is, Object & obj, std::index_sequence<Is...>)
+            {
+                (Read::value(is, std::get<Is>(obj)), ...);
+            }
+
+            template <typename Iterable>
+            void iterable(Source & is, Iterable & iterable)
+            {
+                using Element = RareTs::element_type_t<Iterable>;
+                if constexpr ( detail::is_block_static_array_v<Iterable> )
+                    is.get(&iterable, sizeof(Iterable));
+                else if constexpr ( RareTs::is_static_array_v<Iterable> )
+                {
+                    for ( auto & element : iterable )
+                        Read::value(is, element);
+                }
+                else if constexpr ( detail::is_block_container_v<Iterable> )
+                {
+                    size_t size = is.varint();
+                    if ( size > is.remaining()/sizeof(Element) )
+                        throw UnexpectedInputEnd();
+
+                    iterable.resize(size);
+                    is.get(iterable.data(), size*sizeof(Element));
+                }
+                else
+                {
+                    RareTs::clear(iterable);
+                    size_t size = is.varint();
+                    for ( size_t i=0; i<size; ++i )
+                    {
+                        Element element {};
+                        Read::value(is, element);
+                        RareTs::append(iterable, std::move(element));
+                    }
+                }
+            }
+
+            template <typename Object>
+            void fields(Source & is, Object & obj)
+            {
+                Reflect<Object>::Members::template forEach<Json::IsUnignoredDataMatchingStatics, Json::StaticType<Json::Statics::Excluded>>(obj,
+                    [&](auto & member, auto & value) {
+                        using Member = std::remove_reference_t<decltype(member)>;
+                        using Value = RareTs::remove_cvref_t<decltype(value)>;
+                        if constexpr ( RareTs::is_specialized_v<Customize<Object, Value, Member::index>> )
+                        {
+                            if ( Customize<Object, Value, Member::index>::as(is, obj, value) )
+                                return;
+                        }
+                        else if constexpr ( RareTs::is_specialized_v<Customize<Object, Value>> )
+                        {
+                            if ( Customize<Object, Value>::as(is, obj, value) )
+                                return;
+                        }
+                        Read::value(is, value);
+                    });
+            }
+
+            template <typename Object>
+            void object(Source & is, Object & obj)
+            {
+                Read::fields(is, obj);
+                Reflect<Object>::Supers::forEach(obj, [&](auto superInfo, auto & superObj) {
+                    if constexpr ( !decltype(superInfo)::template hasNote<Json::IgnoreType>() )
+                        Read::object(is, superObj);
+                });
+            }
+
+            template <typename T> void value(Source & is, T & value)
+            {
+                if constexpr ( std::is_const_v<T> )
+                    static_assert(std::is_void_v<T>, "Cannot read into a const value");
+                else if constexpr ( std::is_same_v<bool, T> )
+                    value = is.byte() != 0;
+                else if constexpr ( detail::is_block_copyable_v<T> )
+                    is.get(&value, sizeof(T));
+                else if constexpr ( RareTs::is_optional_v<T> )
+                {
+                    if ( is.byte() != 0 )
+                    {
+                        value.emplace();
+                        Read::value(is, *value);
+                    }
+                    else
+                        value.reset();
+                }
+                else if constexpr ( RareTs::is_pointable_v<T> )
+                {
+                    using Dereferenced = RareTs::remove_pointer_t<T>;
+                    if ( is.byte() == 0 )
+                        value = nullptr;
+                    else if ( value != nullptr )
+                        Read::value(is, *value);
+                    else if constexpr ( std::is_pointer_v<T> ) // Raw pointers are never allocated, the value is read and discarded
+                    {
+                        Dereferenced discard {};
+                        Read::value(is, discard);
+                    }
+                    else
+                    {
+                        value = T(new Dereferenced());
+                        Read::value(is, *value);
+                    }
+                }
+                else if constexpr ( RareTs::is_pair_v<T> )
+                {
+                    Read::value(is, value.first);
+                    Read::value(is, value.second);
+                }
+                else if constexpr ( RareTs::is_tuple_v<T> )
+                    Read::tuple(is, value, std::make_index_sequence<std::tuple_size_v<T>>());
+                else if constexpr ( RareTs::is_iterable_v<T> )
+                    Read::iterable(is, value);
+                else if constexpr ( RareTs::is_reflected_v<T> )
+                    Read::object(is, value);
+                else
+                    static_assert(std::is_void_v<T>, "Type is not supported by binary serialization, consider using a Binary::Customize");
+            }
+        }
+
+        // Deserializes t from input in the binary format, throws UnexpectedInputEnd if input is truncated
+        template <typename T>
+        inline void read(std::string_view input, T & t)
+        {
+            Source source(input);
+            Read::value(source, t);
+        }
+
+        // Deserializes a T from input in the binary format, throws UnexpectedInputEnd if input is truncated
+        template <typename T>
+        inline T read(std::string_view input)
+        {
+            T t {};
+            Binary::read(input, t);
+            return t;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,311 @@
+// MIT License, Copyright (c) 2019-2025 Justin F https://github.com/TheNitesWhoSay/RareCpp/blob/master/LICENSE
+#ifndef DESCRIPTOR_H
+#define DESCRIPTOR_H
+#ifndef JSON_H
+#include "json.h"
+#endif
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Type-erased, constexpr descriptions of types, e.g. "const RareTs::type_descriptor & type = RareTs::describe<Obj>();"
+//
+// Descriptors let generic code run from data rather than from per-type template instantiations: the functions below (writeJson, readJson,
+// equal & differences) are not templates, they walk the member tables of composite types and call the function pointers of leaf types
+//
+// - composites are standard-layout types reflected using the REFLECT macro with no supers whose instance data members all have offsets
+//   (members are REFLECT-ed by name and aren't references), their members are described by name, index, offset, size & type descriptor
+// - every other type is a leaf, leaves are operated on through the function pointers in their descriptor and must be Json-writable & readable
+//
+// Descriptors are unique per type, the address of a descriptor serves as a type id
+namespace RareTs
+{
+    inline namespace Descriptors
+    {
+        struct type_descriptor;
+
+        struct member_descriptor
+        {
+            std::string_view name;
+            size_t index; // The index of the member in RareTs::Members<T>
+            size_t offset;
+            size_t size;
+            const type_descriptor* type;
+            bool jsonIgnored; // Noted with Json::Ignore
+            std::string_view jsonName; // The name of the field in Json, which is given by Json::Name if noted
+        };
+
+        struct type_descriptor
+        {
+            std::string_view name;
+            size_t size;
+            size_t alignment;
+            bool composite;
+            std::span<const member_descriptor> members; // Instance data members of composites, ordered by index
+
+            void (*construct)(void* obj); // Default-constructs at obj, nullptr if T is not default constructible
+            void (*destroy)(void* obj);
+            void (*copy)(void* to, const void* from); // Copy-assigns, nullptr if T is not copy assignable
+            bool (*equal)(const void* l, const void* r); // Leaves with operator== only
+            void (*writeJson)(std::string & output, const void* obj); // Leaves only, appends to output
+            void (*readJson)(std::string_view input, void* obj); // Leaves only
+
+            // The member with the given name, or nullptr if there is none
+            constexpr const member_descriptor* member(std::string_view memberName) const
+            {
+                for ( const auto & described : members )
+                {
+                    if ( described.name == memberName )
+                        return &described;
+                }
+                return nullptr;
+            }
+
+            // The member with the given Json field name, or nullptr if there is none
+            constexpr const member_descriptor* jsonMember(std::string_view fieldName) const
+            {
+                for ( const auto & described : members )
+                {
+                    if ( described.jsonName == fieldName )
+                        return &described;
+                }
+                return nullptr;
+            }
+        };
+
+        template <typename T> constexpr const type_descriptor & describe();
+
+        namespace detail
+        {
+            template <typename T, typename = void> struct has_equal { static constexpr bool value = false; };
+            template <typename T> struct has_equal<T, std::enable_if_t<
+                std::is_convertible_v<decltype(std::declval<const T &>() == std::declval<const T &>()), bool>>> { static constexpr bool value = true; };
+
+            template <typename T, size_t ... Is> constexpr auto instanceData(std::index_sequence<Is...>)
+                -> typename RareTs::type_mask<RareTs::Filter::IsInstanceData, RareTs::Member<T, Is>...>::indexes;
+
+            template <typename T> using instance_data_indexes = decltype(instanceData<T>(std::make_index_sequence<RareTs::Members<T>::total>()));
+
+            template <typename T, size_t ... Is> constexpr bool haveOffsets(std::index_sequence<Is...>)
+            {
+                return ((RareTs::Member<T, Is>::getOffset() != std::numeric_limits<size_t>::max()) && ...);
+            }
+
+            template <typename T> constexpr bool isComposite()
+            {
+                if constexpr ( RareTs::is_macro_reflected_v<T> && std::is_standard_layout_v<T> )
+                {
+                    if constexpr ( RareTs::Supers<T>::total == 0 )
+                        return haveOffsets<T>(instance_data_indexes<T>{});
+                    else
+                        return false;
+                }
+                else
+                    return false;
+            }
+
+            // Whether operator== compiles for T, including for the elements of containers (whose operator== is declared regardless)
+            template <typename T> constexpr bool isEqualityComparable()
+            {
+                if constexpr ( !has_equal<T>::value )
+                    return false;
+                else if constexpr ( RareTs::is_optional_v<T> )
+                    return isEqualityComparable<typename T::value_type>();
+                else if constexpr ( RareTs::is_pair_v<T> )
+                    return isEqualityComparable<typename T::first_type>() && isEqualityComparable<typename T::second_type>();
+                else if constexpr ( RareTs::is_iterable_v<T> )
+                    return isEqualityComparable<RareTs::remove_cvref_t<RareTs::element_type_t<T>>>();
+                else
+                    return true;
+            }
+
+            template <typename Member> constexpr std::string_view jsonName()
+            {
+                if constexpr ( Member::template hasNote<Json::Name>() )
+                    return Member::template getNote<Json::Name>().value;
+                else
+                    return Member::name;
+            }
+
+            template <typename T, size_t ... Is> constexpr auto describeMembers(std::index_sequence<Is...>)
+            {
+                return std::array<member_descriptor, sizeof...(Is)> {
+                    member_descriptor {
+                        RareTs::Member<T, Is>::name,
+                        Is,
+                        RareTs::Member<T, Is>::getOffset(),
+                        sizeof(typename RareTs::Member<T, Is>::type),
+                        &describe<std::remove_cv_t<typename RareTs::Member<T, Is>::type>>(),
+                        RareTs::Member<T, Is>::template hasNote<Json::IgnoreType>(),
+                        jsonName<RareTs::Member<T, Is>>()
+                    }...
+                };
+            }
+
+            template <typename T> inline constexpr auto memberDescriptors = [](){
+                if constexpr ( isComposite<T>() )
+                    return describeMembers<T>(instance_data_indexes<T>{});
+                else
+                    return std::array<member_descriptor, 0> {};
+            }();
+
+            template <typename T> void construct(void* obj) { new (obj) T(); }
+            template <typename T> void destroy(void* obj) { static_cast<T*>(obj)->~T(); }
+            template <typename T> void copy(void* to, const void* from) { *static_cast<T*>(to) = *static_cast<const T*>(from); }
+            template <typename T> bool equal(const void* l, const void* r) { return *static_cast<const T*>(l) == *static_cast<const T*>(r); }
+            template <typename T> void writeJson(std::string & output, const void* obj) { output += Json::write(*static_cast<const T*>(obj)); }
+
+            template <typename T> void readJson(std::string_view input, void* obj)
+            {
+                T & value = *static_cast<T*>(obj);
+                if constexpr ( RareTs::is_optional_v<T> || RareTs::is_pointable_v<T> )
+                {
+                    if ( input == "null" ) // Top-level nulls are not read by Json::read
+                    {
+                        value = T{};
+                        return;
+                    }
+                }
+                Json::read(input, value);
+            }
+
+            template <typename T> constexpr type_descriptor makeDescriptor()
+            {
+                constexpr bool composite = isComposite<T>();
+                using Construct = void(*)(void*);
+                using Copy = void(*)(void*, const void*);
+                using Equal = bool(*)(const void*, const void*);
+                using WriteJson = void(*)(std::string &, const void*);
+                using ReadJson = void(*)(std::string_view, void*);
+                return type_descriptor {
+                    RareTs::toStr<T>(),
+                    sizeof(T),
+                    alignof(T),
+                    composite,
+                    std::span<const member_descriptor>(memberDescriptors<T>),
+                    [](){ if constexpr ( std::is_default_constructible_v<T> ) return &detail::construct<T>; else return Construct{nullptr}; }(),
+                    &detail::destroy<T>,
+                    [](){ if constexpr ( std::is_copy_assignable_v<T> ) return &detail::copy<T>; else return Copy{nullptr}; }(),
+                    [](){ if constexpr ( !composite && isEqualityComparable<T>() ) return &detail::equal<T>; else return Equal{nullptr}; }(),
+                    [](){ if constexpr ( !composite ) return &detail::writeJson<T>; else return WriteJson{nullptr}; }(),
+                    [](){ if constexpr ( !composite ) return &detail::readJson<T>; else return ReadJson{nullptr}; }()
+                };
+            }
+
+            template <typename T> inline constexpr type_descriptor descriptor = makeDescriptor<T>();
+
+            inline void differences(const type_descriptor & type, const void* before, const void* after, std::string & path,
+                std::vector<std::string> & paths);
+        }
+
+        // Gets the descriptor of T, the address of which is unique to T
+        template <typename T> constexpr const type_descriptor & describe()
+        {
+            return detail::descriptor<T>;
+        }
+
+        inline const void* memberAddress(const member_descriptor & member, const void* obj) { return static_cast<const char*>(obj) + member.offset; }
+        inline void* memberAddress(const member_descriptor & member, void* obj) { return static_cast<char*>(obj) + member.offset; }
+
+        // Appends the Json representation of obj to output, composites are written as objects of their members which aren't Json-ignored
+        inline void writeJson(const type_descriptor & type, const void* obj, std::string & output)
+        {
+            if ( !type.composite )
+                return type.writeJson(output, obj);
+
+            output += '{';
+            bool first = true;
+            for ( const auto & member : type.members )
+            {
+                if ( member.jsonIgnored )
+                    continue;
+                else if ( !first )
+                    output += ',';
+
+                first = false;
+                output += '"';
+                output += member.jsonName;
+                output += "\":";
+                writeJson(*member.type, memberAddress(member, obj), output);
+            }
+            output += '}';
+        }
+
+        // Reads the Json representation of obj from input, fields of composites which are unknown or Json-ignored are skipped
+        inline void readJson(const type_descriptor & type, std::string_view input, void* obj)
+        {
+            if ( !type.composite )
+                return type.readJson(input.substr(std::min(input.find_first_not_of(" \t\r\n"), input.size())), obj);
+
+            Json::readFields(input, [&](std::string_view fieldName, std::string_view value) {
+                const member_descriptor* member = type.jsonMember(fieldName);
+                if ( member != nullptr && !member->jsonIgnored )
+                    readJson(*member->type, value, memberAddress(*member, obj));
+            });
+        }
+
+        // Compares composites memberwise and leaves using operator== (or by their Json representations where there is no operator==)
+        inline bool equal(const type_descriptor & type, const void* l, const void* r)
+        {
+            if ( type.composite )
+            {
+                for ( const auto & member : type.members )
+                {
+                    if ( !equal(*member.type, memberAddress(member, l), memberAddress(member, r)) )
+                        return false;
+                }
+                return true;
+            }
+            else if ( type.equal != nullptr )
+                return type.equal(l, r);
+
+            std::string lJson {};
+            std::string rJson {};
+            type.writeJson(lJson, l);
+            type.writeJson(rJson, r);
+            return lJson == rJson;
+        }
+
+        namespace detail
+        {
+            inline void differences(const type_descriptor & type, const void* before, const void* after, std::string & path,
+                std::vector<std::string> & paths)
+            {
+                if ( !type.composite )
+                {
+                    if ( !RareTs::equal(type, before, after) )
+                        paths.push_back(path);
+                    return;
+                }
+
+                size_t pathSize = path.size();
+                for ( const auto & member : type.members )
+                {
+                    path += '/';
+                    path += member.name;
+                    differences(*member.type, memberAddress(member, before), memberAddress(member, after), path, paths);
+                    path.resize(pathSize);
+                }
+            }
+        }
+
+        // Gets the '/' separated paths of the leaves which differ between before and after (e.g. "/pos/x"), "" if a leaf root differs
+        inline std::vector<std::string> differences(const type_descriptor & type, const void* before, const void* after)
+        {
+            std::vector<std::string> paths {};
+            std::string path {};
+            detail::differences(type, before, after, path, paths);
+            return paths;
+        }
+    }
+}
+
+#endif
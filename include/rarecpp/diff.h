@@ -0,0 +1,273 @@
+// MIT License, Copyright (c) 2019-2025 Justin F https://github.com/TheNitesWhoSay/RareCpp/blob/master/LICENSE
+#ifndef DIFF_H
+#define DIFF_H
+#ifndef JSON_H
+#include "json.h"
+#endif
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Structural diff & patch for reflected objects, e.g. "RareTs::Patch patch = RareTs::diff(before, after);" then elsewhere
+// "RareTs::apply(obj, patch);" turns a copy of before into after; patches are reflected and can be sent using Json::out/Json::in
+//
+// Each change pairs a path with the Json representation of the new value at that path, paths are '/' separated segments where:
+// - reflected objects are descended using member names (instance data not noted with Json::Ignore) or super-class field names
+//   as used by Json (e.g. "__Base")
+// - static arrays and random-access containers of equal size are descended by index (e.g. "/points/3/x")
+// - optionals and smart pointers which are non-empty on both sides are descended without a path segment
+// Anything else which differs, including containers whose sizes differ, maps, sets and pairs, is replaced as a whole
+namespace RareTs
+{
+    inline namespace Patching
+    {
+        struct Change
+        {
+            std::string path;
+            std::string value; // The Json representation of the new value
+
+            REFLECT(Change, path, value)
+        };
+
+        struct Patch
+        {
+            std::vector<Change> changes;
+
+            bool empty() const noexcept { return changes.empty(); }
+            size_t size() const noexcept { return changes.size(); }
+
+            REFLECT(Patch, changes)
+        };
+
+        class InvalidPatchPath : public Json::Exception
+        {
+        public:
+            InvalidPatchPath(const std::string & path) : Json::Exception(("Patch path \"" + path + "\" does not exist in the target!").c_str()) {}
+        };
+
+        namespace detail
+        {
+            template <typename T, typename = void> struct has_equal { static constexpr bool value = false; };
+            template <typename T> struct has_equal<T, std::enable_if_t<
+                std::is_convertible_v<decltype(std::declval<const T &>() == std::declval<const T &>()), bool>>> { static constexpr bool value = true; };
+
+            template <typename T, typename = void> struct is_random_access { static constexpr bool value = false; };
+            template <typename T> struct is_random_access<T, std::enable_if_t<std::is_base_of_v<std::random_access_iterator_tag,
+                typename std::iterator_traits<decltype(std::begin(std::declval<T &>()))>::iterator_category>>> {
+                static constexpr bool value = !RareTs::is_map_v<T>;
+            };
+
+            template <typename Member, typename = RareTs::enable_if_member_t<Member>> struct is_patched_member : std::bool_constant<
+                Member::isData && !Member::isStatic && !Member::template hasNote<Json::IgnoreType>()> {}; // Statics & Json-ignored not diffed
+
+            template <typename T> constexpr bool equal(const T & l, const T & r);
+
+            template <typename T, size_t ... Is> constexpr bool tupleEqual(const T & l, const T & r, std::index_sequence<Is...>)
+            {
+                return (detail::equal(std::get<Is>(l), std::get<Is>(r)) && ...);
+            }
+
+            // Compares values using operator== where available (or elementwise/memberwise where not), Json-ignored members don't count
+            template <typename T> constexpr bool equal(const T & l, const T & r)
+            {
+                if constexpr ( RareTs::is_reflected_v<T> && !has_equal<T>::value )
+                {
+                    bool result = true;
+                    RareTs::Members<T>::template forEach<is_patched_member>(l, [&](auto & member, auto & value) {
+                        using Member = RareTs::remove_cvref_t<decltype(member)>;
+                        result = result && detail::equal(value, Member::value(r));
+                    });
+                    RareTs::Supers<T>::forEach(l, [&](auto superInfo, auto & superObj) {
+                        using Super = RareTs::remove_cvref_t<decltype(superObj)>;
+                        if constexpr ( !decltype(superInfo)::template hasNote<Json::IgnoreType>() )
+                            result = result && detail::equal(superObj, static_cast<const Super &>(r));
+                    });
+                    return result;
+                }
+                else if constexpr ( RareTs::is_optional_v<T> )
+                    return l.has_value() == r.has_value() && (!l.has_value() || detail::equal(*l, *r));
+                else if constexpr ( RareTs::is_pointable_v<T> )
+                    return (l == nullptr) == (r == nullptr) && (l == nullptr || detail::equal(*l, *r));
+                else if constexpr ( RareTs::is_pair_v<T> )
+                    return detail::equal(l.first, r.first) && detail::equal(l.second, r.second);
+                else if constexpr ( RareTs::is_tuple_v<T> )
+                    return detail::tupleEqual(l, r, std::make_index_sequence<std::tuple_size_v<T>>());
+                else if constexpr ( RareTs::is_iterable_v<T> && !has_equal<RareTs::element_type_t<T>>::value )
+                {
+                    return std::size(l) == std::size(r) && std::equal(std::begin(l), std::end(l), std::begin(r),
+                        [](const auto & le, const auto & re) { return detail::equal(le, re); });
+                }
+                else
+                    return l == r;
+            }
+
+            template <typename T> inline void diff(std::string & path, const T & before, const T & after, Patch & patch)
+            {
+                if constexpr ( has_equal<T>::value && !RareTs::is_iterable_v<T> )
+                {
+                    if ( before == after ) // Early-out on equal subtrees
+                        return;
+                }
+
+                if constexpr ( RareTs::is_reflected_v<T> )
+                {
+                    size_t pathSize = path.size();
+                    RareTs::Members<T>::template forEach<is_patched_member>(before, [&](auto & member, auto & value) {
+                        using Member = RareTs::remove_cvref_t<decltype(member)>;
+                        path += '/';
+                        path += Member::name;
+                        detail::diff(path, value, Member::value(after), patch);
+                        path.resize(pathSize);
+                    });
+                    RareTs::Supers<T>::forEach(before, [&](auto superInfo, auto & superObj) {
+                        using Super = RareTs::remove_cvref_t<decltype(superObj)>;
+                        if constexpr ( !decltype(superInfo)::template hasNote<Json::IgnoreType>() )
+                        {
+                            path += '/';
+                            path += Json::superTypeJsonFieldName<Super>.view();
+                            detail::diff(path, superObj, static_cast<const Super &>(after), patch);
+                            path.resize(pathSize);
+                        }
+                    });
+                }
+                else if constexpr ( RareTs::is_optional_v<T> || RareTs::is_pointable_v<T> )
+                {
+                    if ( bool(before) && bool(after) )
+                        detail::diff(path, *before, *after, patch);
+                    else if ( bool(before) != bool(after) )
+                        patch.changes.push_back(Change{path, Json::write(after)});
+                }
+                else if constexpr ( is_random_access<T>::value && !std::is_same_v<std::string, T> )
+                {
+                    if ( std::size(before) == std::size(after) )
+                    {
+                        size_t pathSize = path.size();
+                        auto beforeElement = std::begin(before);
+                        auto afterElement = std::begin(after);
+                        for ( size_t i=0; beforeElement != std::end(before); ++i, ++beforeElement, ++afterElement )
+                        {
+                            path += '/';
+                            path += std::to_string(i);
+                            detail::diff(path, *beforeElement, *afterElement, patch);
+                            path.resize(pathSize);
+                        }
+                    }
+                    else
+                        patch.changes.push_back(Change{path, Json::write(after)});
+                }
+                else if ( !detail::equal(before, after) )
+                    patch.changes.push_back(Change{path, Json::write(after)});
+            }
+
+            template <typename T> inline void apply(T & obj, const std::string & fullPath, std::string_view path, const std::string & value)
+            {
+                if ( path.empty() )
+                {
+                    if constexpr ( RareTs::is_optional_v<T> || RareTs::is_pointable_v<T> )
+                    {
+                        if ( value == "null" ) // Nulls are only written for emptied optionals & pointers
+                        {
+                            if constexpr ( RareTs::is_optional_v<T> )
+                                obj.reset();
+                            else
+                                obj = nullptr;
+                            return;
+                        }
+                        else if constexpr ( RareTs::is_optional_v<T> )
+                            obj.emplace();
+                        else if constexpr ( RareTs::is_specialization_v<T, std::unique_ptr> )
+                            obj = std::make_unique<RareTs::remove_cvref_t<decltype(*obj)>>();
+                        else if constexpr ( RareTs::is_specialization_v<T, std::shared_ptr> )
+                            obj = std::make_shared<RareTs::remove_cvref_t<decltype(*obj)>>();
+                        else if ( obj == nullptr )
+                            throw InvalidPatchPath(fullPath);
+
+                        Json::read(value, *obj);
+                    }
+                    else
+                        Json::read(value, obj);
+                    return;
+                }
+                else if ( path[0] != '/' )
+                    throw InvalidPatchPath(fullPath);
+
+                size_t segmentEnd = std::min(path.find('/', 1), path.size());
+                std::string_view segment = path.substr(1, segmentEnd-1);
+                std::string_view rest = path.substr(segmentEnd);
+                if constexpr ( RareTs::is_reflected_v<T> )
+                {
+                    bool found = false;
+                    RareTs::Members<T>::template named<is_patched_member>(segment, obj, [&](auto &, auto & memberValue) {
+                        found = true;
+                        detail::apply(memberValue, fullPath, rest, value);
+                    });
+                    RareTs::Supers<T>::forEach(obj, [&](auto superInfo, auto & superObj) {
+                        using Super = RareTs::remove_cvref_t<decltype(superObj)>;
+                        if constexpr ( !decltype(superInfo)::template hasNote<Json::IgnoreType>() )
+                        {
+                            if ( !found && segment == Json::superTypeJsonFieldName<Super>.view() )
+                            {
+                                found = true;
+                                detail::apply(superObj, fullPath, rest, value);
+                            }
+                        }
+                    });
+                    if ( !found )
+                        throw InvalidPatchPath(fullPath);
+                }
+                else if constexpr ( RareTs::is_optional_v<T> )
+                {
+                    if ( !obj.has_value() )
+                        obj.emplace();
+
+                    detail::apply(*obj, fullPath, path, value);
+                }
+                else if constexpr ( RareTs::is_pointable_v<T> )
+                {
+                    if ( obj == nullptr )
+                        throw InvalidPatchPath(fullPath);
+
+                    detail::apply(*obj, fullPath, path, value);
+                }
+                else if constexpr ( is_random_access<T>::value && !std::is_same_v<std::string, T> )
+                {
+                    size_t index = 0;
+                    auto [end, ec] = std::from_chars(segment.data(), segment.data()+segment.size(), index);
+                    if ( ec != std::errc() || end != segment.data()+segment.size() || index >= size_t(std::size(obj)) )
+                        throw InvalidPatchPath(fullPath);
+
+                    detail::apply(*std::next(std::begin(obj), std::ptrdiff_t(index)), fullPath, rest, value);
+                }
+                else
+                    throw InvalidPatchPath(fullPath);
+            }
+        }
+
+        // Gets the changes needed to turn before into after
+        template <typename T> inline Patch diff(const T & before, const T & after)
+        {
+            Patch patch {};
+            std::string path {};
+            detail::diff(path, before, after, patch);
+            return patch;
+        }
+
+        // Applies the changes in patch to obj, throws InvalidPatchPath if obj lacks a patched path
+        template <typename T> inline void apply(T & obj, const Patch & patch)
+        {
+            for ( const auto & change : patch.changes )
+                detail::apply(obj, change.path, change.path, change.value);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,356 @@
+// MIT License, Copyright (c) 2019-2025 Justin F https://github.com/TheNitesWhoSay/RareCpp/blob/master/LICENSE
+#ifndef DIRTY_H
+#define DIRTY_H
+#ifndef JSON_H
+#include "json.h"
+#endif
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// Dirty-bit tracking of REFLECT-ed objects, e.g. for "struct Player { int hp; Point pos; REFLECT(Player, hp, pos) };"
+//
+// RareTs::dirty_tracked tracked(player); // Adapts player, giving the adapter members of the same names as player's instance data members
+// tracked.hp = 90; // Assigns player.hp and marks hp dirty (assigning an equal value, for types with operator==, marks nothing)
+// tracked.pos.x = 3; // REFLECT-ed members are tracked recursively, marks pos.x and pos dirty
+// tracked.pos.y.edit().push_back(1); // edit() marks a member dirty and returns it for modification in place
+// std::cout << Json::outDirty(tracked); // {"hp":90,"pos":{"x":3,"y":[1]}}, only dirty fields are written
+// tracked.clearDirty();
+//
+// Each instance data member has one flag in a std::bitset held by the adapter, flags of a REFLECT-ed member's own members follow its flag;
+// supers, Json-ignored members and members changed without going through the adapter are not tracked (or written by Json::outDirty)
+namespace RareTs
+{
+    inline namespace DirtyTracking
+    {
+        namespace detail
+        {
+            inline constexpr size_t NoFlag = std::numeric_limits<size_t>::max();
+
+            template <typename T, typename = void> struct has_equal { static constexpr bool value = false; };
+            template <typename T> struct has_equal<T, std::enable_if_t<
+                std::is_convertible_v<decltype(std::declval<const T &>() == std::declval<const T &>()), bool>>> { static constexpr bool value = true; };
+
+            template <typename T> constexpr size_t flagCount();
+
+            // The number of flags used by a member: its own flag plus those of its members if it is REFLECT-ed
+            template <typename Member> constexpr size_t memberFlagCount()
+            {
+                using Type = RareTs::remove_cvref_t<typename Member::type>;
+                if constexpr ( !RareTs::Filter::IsInstanceData<Member>::value )
+                    return 0;
+                else if constexpr ( RareTs::is_macro_reflected_v<Type> )
+                    return 1 + flagCount<Type>();
+                else
+                    return 1;
+            }
+
+            template <typename T, size_t ... Is> constexpr std::array<size_t, sizeof...(Is)> memberFlagCounts(std::index_sequence<Is...>)
+            {
+                return { memberFlagCount<RareTs::Member<T, Is>>()... };
+            }
+
+            template <typename T> inline constexpr auto flagCounts = memberFlagCounts<T>(std::make_index_sequence<RareTs::Members<T>::total>());
+
+            template <typename T> constexpr size_t flagCount()
+            {
+                size_t total = 0;
+                for ( size_t count : flagCounts<T> )
+                    total += count;
+                return total;
+            }
+
+            // The flag of each member relative to the first flag of T, or NoFlag for untracked members
+            template <typename T> inline constexpr auto memberFlags = [](){
+                std::array<size_t, RareTs::Members<T>::total> result {};
+                size_t flag = 0;
+                for ( size_t i=0; i<result.size(); ++i )
+                {
+                    result[i] = flagCounts<T>[i] > 0 ? flag : NoFlag;
+                    flag += flagCounts<T>[i];
+                }
+                return result;
+            }();
+
+            template <typename T, size_t Base, size_t Parent, size_t N, size_t ... Is>
+            constexpr void fillParents(std::array<size_t, N> & parents, std::index_sequence<Is...>);
+
+            template <typename T, size_t Base, size_t Parent, size_t I, size_t N> constexpr void fillParent(std::array<size_t, N> & parents)
+            {
+                if constexpr ( memberFlags<T>[I] != NoFlag )
+                {
+                    constexpr size_t flag = Base + memberFlags<T>[I];
+                    using Type = RareTs::remove_cvref_t<typename RareTs::Member<T, I>::type>;
+                    parents[flag] = Parent;
+                    if constexpr ( RareTs::is_macro_reflected_v<Type> )
+                        fillParents<Type, flag+1, flag>(parents, std::make_index_sequence<RareTs::Members<Type>::total>());
+                }
+            }
+
+            template <typename T, size_t Base, size_t Parent, size_t N, size_t ... Is>
+            constexpr void fillParents(std::array<size_t, N> & parents, std::index_sequence<Is...>)
+            {
+                (fillParent<T, Base, Parent, Is>(parents), ...);
+            }
+
+            // The flag of the REFLECT-ed member containing each flag, or NoFlag for members of the root
+            template <typename Root> inline constexpr auto parentFlags = [](){
+                std::array<size_t, flagCount<Root>()> result {};
+                fillParents<Root, 0, NoFlag>(result, std::make_index_sequence<RareTs::Members<Root>::total>());
+                return result;
+            }();
+
+            template <typename T, size_t ... Is> constexpr auto instanceData(std::index_sequence<Is...>)
+                -> typename RareTs::type_mask<RareTs::Filter::IsInstanceData, RareTs::Member<T, Is>...>::indexes;
+
+            template <typename T> using instance_data_indexes = decltype(instanceData<T>(std::make_index_sequence<RareTs::Members<T>::total>()));
+
+            template <typename Root>
+            class dirty_state
+            {
+            public:
+                static constexpr size_t totalFlags = flagCount<Root>();
+
+                bool isDirty(size_t flag) const { return flags.test(flag); }
+
+                // Marks flag and the flags of the members containing it
+                void markDirty(size_t flag)
+                {
+                    for ( ; flag != NoFlag && !flags.test(flag); flag = parentFlags<Root>[flag] ) // Containing flags are set whenever flag is set
+                        flags.set(flag);
+                }
+
+                void markDirty(size_t first, size_t end)
+                {
+                    for ( size_t flag = first; flag < end; ++flag )
+                        markDirty(flag);
+                }
+
+            protected:
+                std::bitset<totalFlags> flags {};
+            };
+
+            template <typename Root, typename T, size_t Base, typename Indexes = instance_data_indexes<T>> class dirty_members;
+
+            template <typename Root, typename T, size_t Flag, bool Nested = RareTs::is_macro_reflected_v<T>>
+            class dirty_value
+            {
+                T & value;
+                dirty_state<Root> & state;
+
+                template <typename U> dirty_value & assign(U && newValue)
+                {
+                    if constexpr ( has_equal<T>::value )
+                    {
+                        if ( value == newValue )
+                            return *this;
+                    }
+                    value = std::forward<U>(newValue);
+                    state.markDirty(Flag);
+                    return *this;
+                }
+
+            public:
+                dirty_value(T & value, dirty_state<Root> & state) : value(value), state(state) {}
+
+                dirty_value & operator=(const T & newValue) { return assign(newValue); }
+                dirty_value & operator=(T && newValue) { return assign(std::move(newValue)); }
+
+                const T & get() const { return value; }
+                operator const T &() const { return value; }
+                const T* operator->() const { return &value; }
+
+                // Marks the member dirty and returns it for modification in place
+                T & edit()
+                {
+                    state.markDirty(Flag);
+                    return value;
+                }
+
+                bool dirty() const { return state.isDirty(Flag); }
+            };
+
+            template <typename Root, typename T, size_t Flag>
+            class dirty_value<Root, T, Flag, true> : public dirty_members<Root, T, Flag+1>
+            {
+                template <typename U> dirty_value & assign(U && newValue)
+                {
+                    if constexpr ( has_equal<T>::value )
+                    {
+                        if ( this->obj == newValue )
+                            return *this;
+                    }
+                    this->obj = std::forward<U>(newValue);
+                    this->state.markDirty(Flag);
+                    this->state.markDirty(Flag+1, Flag+1+flagCount<T>());
+                    return *this;
+                }
+
+            public:
+                using dirty_members<Root, T, Flag+1>::dirty_members;
+
+                dirty_value & operator=(const T & newValue) { return assign(newValue); }
+                dirty_value & operator=(T && newValue) { return assign(std::move(newValue)); }
+
+                // Marks the member and all of its members dirty and returns it for modification in place
+                T & edit()
+                {
+                    this->state.markDirty(Flag);
+                    this->state.markDirty(Flag+1, Flag+1+flagCount<T>());
+                    return this->obj;
+                }
+
+                bool dirty() const { return this->state.isDirty(Flag); }
+            };
+
+            template <typename Root, typename T, size_t Base>
+            struct dirty_member
+            {
+                template <size_t I>
+                struct type : dirty_value<Root, RareTs::remove_cvref_t<typename RareTs::Member<T, I>::type>, Base + memberFlags<T>[I]>
+                {
+                    using dirty_value<Root, RareTs::remove_cvref_t<typename RareTs::Member<T, I>::type>, Base + memberFlags<T>[I]>::dirty_value;
+                    using dirty_value<Root, RareTs::remove_cvref_t<typename RareTs::Member<T, I>::type>, Base + memberFlags<T>[I]>::operator=;
+                };
+            };
+
+            template <typename Root, typename T, size_t Base, size_t ... Is>
+            class dirty_members<Root, T, Base, std::index_sequence<Is...>>
+                : public RareTs::Class::adapt_member<dirty_member<Root, T, Base>::template type, T, Is>...
+            {
+            protected:
+                T & obj;
+                dirty_state<Root> & state;
+
+            public:
+                dirty_members(T & obj, dirty_state<Root> & state)
+                    : RareTs::Class::adapt_member<dirty_member<Root, T, Base>::template type, T, Is> {{ RareTs::Member<T, Is>::value(obj), state }}...,
+                    obj(obj), state(state) {}
+
+                dirty_members(const dirty_members &) = delete;
+
+                const T & get() const { return obj; }
+                operator const T &() const { return obj; }
+                const T* operator->() const { return &obj; }
+            };
+        }
+
+        // Adapts a REFLECT-ed object, tracking which members are changed through the adapter; the object must outlive the adapter
+        template <typename T>
+        class dirty_tracked : public detail::dirty_state<T>, public detail::dirty_members<T, T, 0>
+        {
+            static_assert(RareTs::is_macro_reflected_v<T>, "Dirty tracking requires a type reflected using the REFLECT macro");
+
+        public:
+            using flags_type = std::bitset<detail::dirty_state<T>::totalFlags>;
+
+            dirty_tracked(T & obj) : detail::dirty_state<T>(), detail::dirty_members<T, T, 0>(obj, *this) {}
+
+            bool dirty() const { return this->flags.any(); }
+            const flags_type & dirtyFlags() const { return this->flags; }
+            void clearDirty() { this->flags.reset(); }
+
+            // Marks every member dirty, e.g. so the next Json::outDirty writes the whole object
+            void markAllDirty() { this->flags.set(); }
+        };
+    }
+}
+
+namespace Json
+{
+    inline namespace Output
+    {
+        namespace Put
+        {
+            template <size_t Base, typename T, typename Flags>
+            inline void dirtyObject(OutStreamType & os, Context & context, const T & obj, const Flags & flags)
+            {
+                os << "{";
+                bool first = true;
+                Reflect<T>::Members::template forEach<IsUnignoredDataMatchingStatics, StaticType<Statics::Excluded>>(obj, [&](auto & member, auto & value) {
+                    using Member = std::remove_reference_t<decltype(member)>;
+                    using Type = RareTs::remove_cvref_t<decltype(value)>;
+                    constexpr size_t flag = Base + RareTs::DirtyTracking::detail::memberFlags<T>[Member::index];
+                    if ( !flags.test(flag) )
+                        return;
+
+                    if ( !first )
+                        os << ",";
+
+                    first = false;
+                    if constexpr ( Member::template hasNote<Json::Name>() )
+                        Put::string(os, member.template getNote<Json::Name>().value);
+                    else
+                        Put::string(os, member.name);
+
+                    os << ":";
+                    if constexpr ( RareTs::is_macro_reflected_v<Type> )
+                        Put::dirtyObject<flag+1>(os, context, value, flags);
+                    else
+                        Put::value<RareTs::NoNote, Member, Statics::Excluded, false, 0, twoSpaces, T, false>(os, context, obj, value);
+                });
+                os << "}";
+            }
+        }
+
+        template <typename T>
+        class DirtyObject
+        {
+        public:
+            DirtyObject(const RareTs::dirty_tracked<T> & tracked, std::shared_ptr<Context> context) : tracked(tracked), context(context) {}
+
+            const RareTs::dirty_tracked<T> & tracked;
+            std::shared_ptr<Context> context;
+
+            OutStreamType & put(OutStreamType & os)
+            {
+                if ( context == nullptr )
+                    context = std::make_shared<Context>();
+
+                Put::dirtyObject<0>(os, *context, tracked.get(), tracked.dirtyFlags());
+                return os;
+            }
+        };
+
+#ifdef USE_BUFFERED_STREAMS
+        template <typename T> inline StringBuffer & operator<<(StringBuffer & os, Output::DirtyObject<T> object)
+        {
+            return object.put(os);
+        }
+
+        template <typename T> inline std::ostream & operator<<(StringBufferPtr os, Output::DirtyObject<T> object)
+        {
+            return object.put(*os);
+        }
+#else
+        template <typename T> inline std::ostream & operator<<(std::ostream & os, Output::DirtyObject<T> object)
+        {
+            return object.put(os);
+        }
+#endif
+
+        // Writes only the members of the tracked object which are marked dirty, "{}" if none are
+        template <typename T> inline Output::DirtyObject<T> outDirty(const RareTs::dirty_tracked<T> & tracked, std::shared_ptr<Context> context = nullptr)
+        {
+            return Output::DirtyObject<T>(tracked, context);
+        }
+
+        template <typename T> inline std::string writeDirty(const RareTs::dirty_tracked<T> & tracked, std::shared_ptr<Context> context = nullptr)
+        {
+            #ifdef USE_BUFFERED_STREAMS
+            StringBuffer ss;
+            #else
+            std::stringstream ss;
+            #endif
+            Output::DirtyObject<T>(tracked, context).put(ss);
+            return ss.str();
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,188 @@
+// MIT License, Copyright (c) 2019-2025 Justin F https://github.com/TheNitesWhoSay/RareCpp/blob/master/LICENSE
+#ifndef HASH_H
+#define HASH_H
+#ifndef REFLECT_H
+#include "reflect.h"
+#endif
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+// Reflection-driven hashing, e.g. "std::unordered_set<MyObj, RareTs::hasher<MyObj>> set;" or "size_t h = RareTs::hash(myObj);"
+//
+// - reflected objects combine the hashes of their instance data members and supers, skipping those noted with RareTs::HashIgnore
+// - reflected objects (and static arrays of them) without padding, floating point members, supers or ignored members are hashed as one
+//   block of bytes using RareTs::hashBytes, as are contiguous containers of such elements
+// - other types with an enabled std::hash specialization use std::hash (reflected types never do, so std::hash may be specialized using
+//   RareTs::hasher)
+// - optionals, pairs, tuples, static arrays and iterables combine the hashes of their elements (order-independently for unordered
+//   containers so equal containers hash equally)
+namespace RareTs
+{
+    inline namespace Hashing
+    {
+        struct HashIgnoreType {};
+        inline constexpr HashIgnoreType HashIgnore {};
+
+        // MurmurHash64A over size bytes, hashing eight bytes at a time
+        inline size_t hashBytes(const void* data, size_t size, std::uint64_t seed = 0)
+        {
+            constexpr std::uint64_t m = 0xc6a4a7935bd1e995ull;
+            constexpr int r = 47;
+            std::uint64_t h = seed ^ (std::uint64_t(size) * m);
+
+            const unsigned char* p = static_cast<const unsigned char*>(data);
+            const unsigned char* blocksEnd = p + (size & ~size_t(7));
+            for ( ; p != blocksEnd; p += 8 )
+            {
+                std::uint64_t k = 0;
+                std::memcpy(&k, p, 8);
+                k *= m;
+                k ^= k >> r;
+                k *= m;
+                h ^= k;
+                h *= m;
+            }
+
+            switch ( size & 7 )
+            {
+                case 7: h ^= std::uint64_t(p[6]) << 48; [[fallthrough]];
+                case 6: h ^= std::uint64_t(p[5]) << 40; [[fallthrough]];
+                case 5: h ^= std::uint64_t(p[4]) << 32; [[fallthrough]];
+                case 4: h ^= std::uint64_t(p[3]) << 24; [[fallthrough]];
+                case 3: h ^= std::uint64_t(p[2]) << 16; [[fallthrough]];
+                case 2: h ^= std::uint64_t(p[1]) << 8; [[fallthrough]];
+                case 1: h ^= std::uint64_t(p[0]); h *= m; break;
+                default: break;
+            }
+
+            h ^= h >> r;
+            h *= m;
+            h ^= h >> r;
+            return size_t(h);
+        }
+
+        constexpr size_t hashCombine(size_t seed, size_t hash)
+        {
+            return seed ^ (hash + size_t(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+        }
+
+        template <typename T> struct is_std_hashable { static constexpr bool value = std::is_default_constructible_v<std::hash<T>>; };
+        template <typename T> inline constexpr bool is_std_hashable_v = is_std_hashable<T>::value;
+
+        namespace detail
+        {
+            template <typename T, typename = void> struct is_unordered { static constexpr bool value = false; };
+            template <typename T> struct is_unordered<T, std::void_t<typename T::hasher>> { static constexpr bool value = true; };
+
+            template <typename T, typename = void> struct is_contiguous { static constexpr bool value = false; };
+            template <typename T> struct is_contiguous<T, std::enable_if_t<
+                std::is_pointer_v<decltype(std::data(std::declval<const T &>()))>>> { static constexpr bool value = true; };
+        }
+
+        // True if T has a unique object representation whose every byte should contribute to its hash
+        template <typename T> constexpr bool isBulkHashable()
+        {
+            if constexpr ( !std::has_unique_object_representations_v<T> )
+                return false;
+            else if constexpr ( std::is_array_v<T> )
+                return isBulkHashable<std::remove_all_extents_t<T>>();
+            else if constexpr ( RareTs::is_reflected_v<T> )
+            {
+                return RareTs::Supers<T>::total == 0 && RareTs::Members<T>::template pack<RareTs::Filter::IsInstanceData>([](auto ... member) {
+                    return ((!decltype(member)::template hasNote<HashIgnoreType>() && isBulkHashable<typename decltype(member)::type>()) && ...) &&
+                        (sizeof(typename decltype(member)::type) + ... + size_t(0)) == sizeof(T); // Else some state isn't reflected
+                });
+            }
+            else
+                return std::is_scalar_v<T>;
+        }
+
+        template <typename T> inline size_t hash(const T & value);
+
+        namespace detail
+        {
+            template <typename T, size_t ... Is> inline size_t hashTuple(const T & value, std::index_sequence<Is...>)
+            {
+                size_t seed = 0;
+                ((seed = hashCombine(seed, RareTs::hash(std::get<Is>(value)))), ...);
+                return seed;
+            }
+        }
+
+        template <typename T> inline size_t hash(const T & value)
+        {
+            if constexpr ( (RareTs::is_reflected_v<T> || std::is_array_v<T>) && isBulkHashable<T>() )
+                return hashBytes(&value, sizeof(T));
+            else if constexpr ( RareTs::is_reflected_v<T> )
+            {
+                size_t seed = 0;
+                RareTs::Members<T>::template forEach<RareTs::Filter::IsInstanceData>(value, [&](auto & member, auto & memberValue) {
+                    if constexpr ( !RareTs::remove_cvref_t<decltype(member)>::template hasNote<HashIgnoreType>() )
+                        seed = hashCombine(seed, RareTs::hash(memberValue));
+                });
+                RareTs::Supers<T>::forEach(value, [&](auto superInfo, auto & superObj) {
+                    if constexpr ( !decltype(superInfo)::template hasNote<HashIgnoreType>() )
+                        seed = hashCombine(seed, RareTs::hash(superObj));
+                });
+                return seed;
+            }
+            else if constexpr ( RareTs::is_std_hashable_v<T> )
+                return std::hash<T>{}(value);
+            else if constexpr ( RareTs::is_optional_v<T> )
+                return value.has_value() ? hashCombine(1, RareTs::hash(*value)) : 0;
+            else if constexpr ( RareTs::is_pair_v<T> )
+                return hashCombine(RareTs::hash(value.first), RareTs::hash(value.second));
+            else if constexpr ( RareTs::is_tuple_v<T> )
+                return detail::hashTuple(value, std::make_index_sequence<std::tuple_size_v<T>>());
+            else if constexpr ( RareTs::is_iterable_v<T> )
+            {
+                using Element = RareTs::remove_cvref_t<decltype(*std::begin(value))>;
+                if constexpr ( detail::is_contiguous<T>::value && isBulkHashable<Element>() )
+                    return hashBytes(std::data(value), std::size(value)*sizeof(Element));
+                else if constexpr ( detail::is_unordered<T>::value )
+                {
+                    size_t sum = 0;
+                    size_t size = 0;
+                    for ( const auto & element : value )
+                    {
+                        sum += RareTs::hash(element);
+                        ++size;
+                    }
+                    return hashCombine(size, sum);
+                }
+                else
+                {
+                    size_t seed = 0;
+                    size_t size = 0;
+                    for ( const auto & element : value )
+                    {
+                        seed = hashCombine(seed, RareTs::hash(element));
+                        ++size;
+                    }
+                    return hashCombine(size, seed);
+                }
+            }
+            else if constexpr ( std::is_class_v<T> && std::has_unique_object_representations_v<T> )
+                return hashBytes(&value, sizeof(T));
+            else
+            {
+                static_assert(RareTs::is_std_hashable_v<T>, "Type is not hashable: not reflected, iterable, std::hash-able or trivially comparable");
+                return 0;
+            }
+        }
+
+        // A hash functor for use in unordered containers, e.g. std::unordered_map<MyKey, int, RareTs::hasher<MyKey>>
+        template <typename T>
+        struct hasher
+        {
+            size_t operator()(const T & value) const { return RareTs::hash(value); }
+        };
+    }
+}
+
+#endif
@@ -4,28 +4,38 @@
 #ifndef REFLECT_H // This check, while normally redundant to have here, helps the file work on godbolt
 #include "reflect.h"
 #endif
-#ifdef USE_BUFFERED_STREAMS
 #include "string_buffer.h"
-#endif
+#include <array>
 #include <cctype>
+#include <charconv>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <exception>
 #include <functional>
 #include <istream>
 #include <limits>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <ostream>
 #include <sstream>
+#include <streambuf>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <typeindex>
 #include <utility>
 #include <vector>
+#ifndef RARE_NO_CPP_20
+#include <span>
+#endif
 
 namespace Json
 {
@@ -180,7 +190,10 @@ namespace Json
 
         struct Context
         {
+            Context(std::pmr::memory_resource* memory = std::pmr::get_default_resource()) : memory(memory) {}
             virtual ~Context() = default;
+
+            std::pmr::memory_resource* memory; // Scratch allocations made while reading (e.g. field names) come from here, e.g. a per-request arena
         };
         inline Context defaultContext;
 
@@ -221,15 +234,68 @@ namespace Json
                 return simpleTypeStr;
             }
 
+            // The super-class field name of T ("__" followed by simplifyTypeStr(RareTs::toStr<T>())), built at compile time
+            template <typename T>
+            struct SuperTypeJsonFieldName
+            {
+                template <typename Emit> static constexpr void simplify(Emit && emit)
+                { // Matches simplifyTypeStr, including erasing the leading characters wherever "struct " or "class " is found
+                    std::string_view typeStr = RareTs::toStr<T>();
+                    if ( typeStr.find("struct ") != std::string_view::npos )
+                        typeStr.remove_prefix(std::string_view("struct ").size());
+                    if ( typeStr.find("class ") != std::string_view::npos )
+                        typeStr.remove_prefix(std::string_view("class ").size());
+
+                    for ( size_t i=0; i<typeStr.size(); i++ )
+                    {
+                        if ( typeStr[i] != ' ' )
+                            emit(typeStr[i]);
+                        else if ( ++i < typeStr.size() ) // Remove space and upper-case the letter following the space
+                            emit(typeStr[i] >= 'a' && typeStr[i] <= 'z' ? static_cast<char>(typeStr[i]-'a'+'A') : typeStr[i]);
+                    }
+                }
+
+                static constexpr size_t length = [](){
+                    size_t total = 2;
+                    simplify([&](char) { ++total; });
+                    return total;
+                }();
+
+                constexpr SuperTypeJsonFieldName() : value(), quoted() {
+                    size_t i = 0;
+                    value[i++] = '_';
+                    value[i++] = '_';
+                    simplify([&](char c) { value[i++] = c; });
+                    value[length] = '\0';
+
+                    quoted[0] = '\"';
+                    for ( i=0; i<length; i++ )
+                        quoted[i+1] = value[i];
+
+                    quoted[length+1] = '\"';
+                    quoted[length+2] = '\0';
+                }
+                char value[length+1];
+                char quoted[length+3]; // value surrounded by quotes, written as-is since type names contain nothing requiring escapes
+
+                constexpr std::string_view view() const { return std::string_view(value, length); }
+                constexpr operator std::string_view() const { return view(); }
+            };
+
+            template <typename T>
+            inline constexpr SuperTypeJsonFieldName<T> superTypeJsonFieldName {};
+
             template <typename T>
             inline std::string superTypeToJsonFieldName()
             {
-                return std::string("__") + simplifyTypeStr(std::string(RareTs::toStr<T>()));
+                return std::string(superTypeJsonFieldName<T>.view());
             }
 
+            inline constexpr std::string_view fieldClusterJsonFieldName = "____fieldCluster";
+
             inline std::string fieldClusterToJsonFieldName()
             {
-                return std::string("____fieldCluster");
+                return std::string(fieldClusterJsonFieldName);
             }
         }
     }
@@ -252,6 +318,261 @@ namespace Json
             Type type;
             std::string name;
         };
+
+        // A json number held as an int64, uint64 or double when that can be written back out as exactly the text it was read from,
+        // otherwise (e.g. "1e5", "007" or numbers beyond the range of a double) the original text is kept
+        class Numeric {
+        public:
+            enum class Kind : uint8_t { Int, Uint, Double, Text };
+
+            static constexpr size_t maxChars = 32; // Enough for any int64, uint64 or shortest round-trip double
+
+            Numeric() : kind_(Kind::Int), integer(0) {}
+            Numeric(std::string_view text) : Numeric() { parse(text); }
+            Numeric(const std::string & text) : Numeric(std::string_view(text)) {}
+            Numeric(const char* text) : Numeric(std::string_view(text)) {}
+            template <typename T, std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
+            Numeric(T value) : Numeric() { set(value); }
+            Numeric(const Numeric & other) : Numeric() { *this = other; }
+            Numeric(Numeric && other) noexcept : Numeric() { *this = std::move(other); }
+            ~Numeric() { clear(); }
+
+            Numeric & operator=(const Numeric & other)
+            {
+                if ( this != &other )
+                {
+                    clear();
+                    kind_ = other.kind_;
+                    switch ( other.kind_ )
+                    {
+                        case Kind::Int: integer = other.integer; break;
+                        case Kind::Uint: unsignedInteger = other.unsignedInteger; break;
+                        case Kind::Double: decimal = other.decimal; break;
+                        case Kind::Text: text = new std::string(*other.text); break;
+                    }
+                }
+                return *this;
+            }
+
+            Numeric & operator=(Numeric && other) noexcept
+            {
+                if ( this != &other )
+                {
+                    clear();
+                    kind_ = other.kind_;
+                    switch ( other.kind_ )
+                    {
+                        case Kind::Int: integer = other.integer; break;
+                        case Kind::Uint: unsignedInteger = other.unsignedInteger; break;
+                        case Kind::Double: decimal = other.decimal; break;
+                        case Kind::Text: text = other.text; other.kind_ = Kind::Int; other.integer = 0; break;
+                    }
+                }
+                return *this;
+            }
+
+            Kind kind() const { return kind_; }
+
+            // Converts the number to value, returns false (leaving value unchanged) if the number doesn't fit in a T, would lose precision
+            // or a fractional part as a T, or is stored as text which cannot be parsed as a T
+            template <typename T>
+            bool get(T & value) const
+            {
+                switch ( kind_ )
+                {
+                    case Kind::Int: return getInteger(integer, value);
+                    case Kind::Uint: return getInteger(unsignedInteger, value);
+                    case Kind::Double: return getDecimal(decimal, value);
+                    case Kind::Text:
+                    {
+                        if constexpr ( std::is_integral_v<T> && !std::is_same_v<T, bool> )
+                        {
+                            const char* end = text->data() + text->size();
+                            auto [p, ec] = std::from_chars(text->data(), end, value);
+                            return ec == std::errc() && p == end;
+                        }
+                        else
+                        {
+                            char* end = nullptr;
+                            double parsed = std::strtod(text->c_str(), &end);
+                            if ( end != text->c_str() + text->size() || text->empty() )
+                                return false;
+
+                            return getDecimal(parsed, value);
+                        }
+                    }
+                }
+                return false;
+            }
+
+            template <typename T>
+            T as() const
+            {
+                T value {};
+                get(value);
+                return value;
+            }
+
+            // Writes the number to buffer (which must hold maxChars) unless stored as text, returns the number of chars written
+            size_t format(char* buffer) const
+            {
+                std::to_chars_result result {buffer, std::errc()};
+                switch ( kind_ )
+                {
+                    case Kind::Int: result = std::to_chars(buffer, buffer+maxChars, integer); break;
+                    case Kind::Uint: result = std::to_chars(buffer, buffer+maxChars, unsignedInteger); break;
+                    case Kind::Double:
+#ifdef __cpp_lib_to_chars
+                        result = std::to_chars(buffer, buffer+maxChars, decimal);
+#else
+                        result.ptr = buffer + std::snprintf(buffer, maxChars, "%.17g", decimal);
+#endif
+                        break;
+                    case Kind::Text: break;
+                }
+                return result.ptr - buffer;
+            }
+
+            std::string str() const
+            {
+                if ( kind_ == Kind::Text )
+                    return *text;
+
+                char buffer[maxChars];
+                return std::string(buffer, format(buffer));
+            }
+
+            template <typename OutStream>
+            void put(OutStream & os) const
+            {
+                if ( kind_ == Kind::Text )
+                    os << *text;
+                else
+                {
+                    char buffer[maxChars+1];
+                    buffer[format(buffer)] = '\0';
+                    os << (const char*)buffer;
+                }
+            }
+
+            bool operator==(const Numeric & other) const { return str() == other.str(); }
+            bool operator!=(const Numeric & other) const { return !(*this == other); }
+
+        private:
+            template <typename T, typename I>
+            static bool getInteger(I integral, T & value)
+            {
+                if constexpr ( std::is_floating_point_v<T> )
+                {
+                    T converted = static_cast<T>(integral);
+                    if ( converted >= std::ldexp(T(1), std::numeric_limits<I>::digits) || static_cast<I>(converted) != integral )
+                        return false; // Not exactly representable as a T
+                    
+                    value = converted;
+                    return true;
+                }
+                else
+                {
+                    bool fits = false;
+                    if constexpr ( std::is_signed_v<I> == std::is_signed_v<T> )
+                        fits = integral >= std::numeric_limits<T>::min() && integral <= std::numeric_limits<T>::max();
+                    else if constexpr ( std::is_signed_v<I> )
+                        fits = integral >= 0 && std::make_unsigned_t<I>(integral) <= std::make_unsigned_t<I>(std::numeric_limits<T>::max());
+                    else
+                        fits = integral <= std::make_unsigned_t<T>(std::numeric_limits<T>::max());
+
+                    if ( fits )
+                        value = static_cast<T>(integral);
+
+                    return fits;
+                }
+            }
+
+            template <typename T>
+            static bool getDecimal(double decimal, T & value)
+            {
+                if constexpr ( std::is_floating_point_v<T> )
+                {
+                    if ( std::isfinite(decimal) && std::fabs(decimal) > std::numeric_limits<T>::max() )
+                        return false;
+                }
+                else if ( !std::isfinite(decimal) || std::trunc(decimal) != decimal || // Has a fractional part
+                    decimal < static_cast<double>(std::numeric_limits<T>::min()) || decimal >= std::ldexp(1.0, std::numeric_limits<T>::digits) )
+                {
+                    return false;
+                }
+                value = static_cast<T>(decimal);
+                return true;
+            }
+
+            void clear()
+            {
+                if ( kind_ == Kind::Text )
+                    delete text;
+
+                kind_ = Kind::Int;
+                integer = 0;
+            }
+
+            template <typename T>
+            void set(T value)
+            {
+                clear();
+                if constexpr ( std::is_floating_point_v<T> )
+                {
+                    kind_ = Kind::Double;
+                    decimal = static_cast<double>(value);
+                }
+                else if constexpr ( std::is_signed_v<T> )
+                    integer = static_cast<int64_t>(value);
+                else
+                {
+                    kind_ = Kind::Uint;
+                    unsignedInteger = static_cast<uint64_t>(value);
+                }
+            }
+
+            // Stores the parsed representation of chars if formatting it reproduces chars exactly, else stores a copy of chars
+            void parse(std::string_view chars)
+            {
+                const char* begin = chars.data();
+                const char* end = chars.data() + chars.size();
+                char buffer[maxChars];
+                if ( !chars.empty() && chars.size() <= maxChars )
+                {
+                    if ( auto [p, ec] = std::from_chars(begin, end, integer); ec == std::errc() && p == end )
+                    {
+                        kind_ = Kind::Int;
+                        if ( format(buffer) == chars.size() && std::memcmp(buffer, begin, chars.size()) == 0 )
+                            return;
+                    }
+                    else if ( auto [p, ec] = std::from_chars(begin, end, unsignedInteger); ec == std::errc() && p == end )
+                    {
+                        kind_ = Kind::Uint;
+                        if ( format(buffer) == chars.size() && std::memcmp(buffer, begin, chars.size()) == 0 )
+                            return;
+                    }
+#ifdef __cpp_lib_to_chars
+                    else if ( auto [p, ec] = std::from_chars(begin, end, decimal); ec == std::errc() && p == end )
+                    {
+                        kind_ = Kind::Double;
+                        if ( format(buffer) == chars.size() && std::memcmp(buffer, begin, chars.size()) == 0 )
+                            return;
+                    }
+#endif
+                }
+                kind_ = Kind::Text;
+                text = new std::string(chars);
+            }
+
+            Kind kind_;
+            union {
+                int64_t integer;
+                uint64_t unsignedInteger;
+                double decimal;
+                std::string* text;
+            };
+        };
         
         class Value {
         public:
@@ -416,13 +737,13 @@ namespace Json
             virtual Type type() const = 0;
             
             virtual bool & boolean() = 0;
-            virtual std::string & number() = 0;
+            virtual Numeric & number() = 0;
             virtual std::string & string() = 0;
             virtual std::map<std::string, std::shared_ptr<Value>> & object() = 0;
             virtual std::vector<std::pair<std::string, std::shared_ptr<Value>>> & orderedObject() = 0;
 
             virtual const bool & boolean() const = 0;
-            virtual const std::string & number() const = 0;
+            virtual const Numeric & number() const = 0;
             virtual const std::string & string() const = 0;
             virtual const std::map<std::string, std::shared_ptr<Value>> & object() const = 0;
             virtual const std::vector<std::pair<std::string, std::shared_ptr<Value>>> & orderedObject() const = 0;
@@ -431,7 +752,7 @@ namespace Json
             
             virtual size_t & nullArray() = 0;
             virtual std::vector<bool> & boolArray() = 0;
-            virtual std::vector<std::string> & numberArray() = 0;
+            virtual std::vector<Numeric> & numberArray() = 0;
             virtual std::vector<std::string> & stringArray() = 0;
             virtual std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() = 0;
             virtual std::vector<std::vector<std::pair<std::string, std::shared_ptr<Value>>>> & orderedObjectArray() = 0;
@@ -439,7 +760,7 @@ namespace Json
             
             virtual const size_t & nullArray() const = 0;
             virtual const std::vector<bool> & boolArray() const = 0;
-            virtual const std::vector<std::string> & numberArray() const = 0;
+            virtual const std::vector<Numeric> & numberArray() const = 0;
             virtual const std::vector<std::string> & stringArray() const = 0;
             virtual const std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() const = 0;
             virtual const std::vector<std::vector<std::pair<std::string, std::shared_ptr<Value>>>> & orderedObjectArray() const = 0;
@@ -448,13 +769,13 @@ namespace Json
             template <typename T>
             bool getNumber(T & num) const
             {
-                return (std::stringstream(number()) >> num).good();
+                return number().get(num);
             }
 
             template <typename T>
             void setNumber(const T & number)
             {
-                number() = std::to_string(number);
+                this->number() = Numeric(number);
             }
         };
         
@@ -472,7 +793,7 @@ namespace Json
             Type type() const final { return Value::Type::Boolean; }
             
             bool & boolean() final { return value; }
-            std::string & number() final { throw TypeMismatch(Value::Type::Boolean, Value::Type::Number, "number"); }
+            Numeric & number() final { throw TypeMismatch(Value::Type::Boolean, Value::Type::Number, "number"); }
             std::string & string() final { throw TypeMismatch(Value::Type::Boolean, Value::Type::String, "string"); }
             std::map<std::string, std::shared_ptr<Value>> & object() final { throw TypeMismatch(Value::Type::Boolean, Value::Type::Object, "object"); }
             std::vector<std::pair<std::string, std::shared_ptr<Value>>> & orderedObject() final {
@@ -480,7 +801,7 @@ namespace Json
             }
 
             const bool & boolean() const final { return value; }
-            const std::string & number() const final { throw TypeMismatch(Value::Type::Boolean, Value::Type::Number, "number"); }
+            const Numeric & number() const final { throw TypeMismatch(Value::Type::Boolean, Value::Type::Number, "number"); }
             const std::string & string() const final { throw TypeMismatch(Value::Type::Boolean, Value::Type::String, "string"); }
             const std::map<std::string, std::shared_ptr<Value>> & object() const final {
                 throw TypeMismatch(Value::Type::Boolean, Value::Type::Object, "object");
@@ -493,7 +814,7 @@ namespace Json
             
             size_t & nullArray() final { throw TypeMismatch(Value::Type::Boolean, Value::Type::NullArray, "nullArray"); }
             std::vector<bool> & boolArray() final { throw TypeMismatch(Value::Type::Boolean, Value::Type::BoolArray, "boolArray"); }
-            std::vector<std::string> & numberArray() final { throw TypeMismatch(Value::Type::Boolean, Value::Type::NumberArray, "numberArray"); }
+            std::vector<Numeric> & numberArray() final { throw TypeMismatch(Value::Type::Boolean, Value::Type::NumberArray, "numberArray"); }
             std::vector<std::string> & stringArray() final { throw TypeMismatch(Value::Type::Boolean, Value::Type::StringArray, "stringArray"); }
             std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() final {
                 throw TypeMismatch(Value::Type::Boolean, Value::Type::ObjectArray, "objectArray");
@@ -505,7 +826,7 @@ namespace Json
             
             const size_t & nullArray() const final { throw TypeMismatch(Value::Type::Boolean, Value::Type::NullArray, "nullArray"); }
             const std::vector<bool> & boolArray() const final { throw TypeMismatch(Value::Type::Boolean, Value::Type::BoolArray, "boolArray"); }
-            const std::vector<std::string> & numberArray() const final { throw TypeMismatch(Value::Type::Boolean, Value::Type::NumberArray, "numberArray"); }
+            const std::vector<Numeric> & numberArray() const final { throw TypeMismatch(Value::Type::Boolean, Value::Type::NumberArray, "numberArray"); }
             const std::vector<std::string> & stringArray() const final { throw TypeMismatch(Value::Type::Boolean, Value::Type::StringArray, "stringArray"); }
             const std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() const final {
                 throw TypeMismatch(Value::Type::Boolean, Value::Type::ObjectArray, "objectArray");
@@ -522,12 +843,12 @@ namespace Json
         };
         class Number final : public Value {
         public:
-            Number() : value("0") {}
+            Number() : value() {}
+            Number(const Numeric & value) : value(value) {}
             Number(const std::string & value) : value(value) {}
             Number(const Number & other) : value(other.value) {}
             Number(const char* value) : value(value) {}
-            template <size_t N> Number(const char(&value)[N]) : value(value, N) {}
-            template <typename T> Number(const T & value) : value(std::to_string(value)) {}
+            template <typename T, std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr> Number(const T & value) : value(value) {}
             
             Number & operator=(const Value & other) { value = other.number(); return *this; }
             Number & operator=(const Number & other) { value = other.number(); return *this; }
@@ -535,7 +856,7 @@ namespace Json
             Type type() const final { return Value::Type::Number; }
             
             bool & boolean() final { throw TypeMismatch(Value::Type::Number, Value::Type::Boolean, "bool"); }
-            std::string & number() final { return value; }
+            Numeric & number() final { return value; }
             std::string & string() final { throw TypeMismatch(Value::Type::Number, Value::Type::String, "string"); }
             std::map<std::string, std::shared_ptr<Value>> & object() final { throw TypeMismatch(Value::Type::Number, Value::Type::Object, "object"); }
             std::vector<std::pair<std::string, std::shared_ptr<Value>>> & orderedObject() final {
@@ -543,7 +864,7 @@ namespace Json
             }
 
             const bool & boolean() const final { throw TypeMismatch(Value::Type::Number, Value::Type::Boolean, "bool"); }
-            const std::string & number() const final { return value; }
+            const Numeric & number() const final { return value; }
             const std::string & string() const final { throw TypeMismatch(Value::Type::Number, Value::Type::String, "string"); }
             const std::map<std::string, std::shared_ptr<Value>> & object() const final {
                 throw TypeMismatch(Value::Type::Number, Value::Type::Object, "object");
@@ -556,7 +877,7 @@ namespace Json
             
             size_t & nullArray() final { throw TypeMismatch(Value::Type::Number, Value::Type::NullArray, "nullArray"); }
             std::vector<bool> & boolArray() final { throw TypeMismatch(Value::Type::Number, Value::Type::BoolArray, "boolArray"); }
-            std::vector<std::string> & numberArray() final { throw TypeMismatch(Value::Type::Number, Value::Type::NumberArray, "numberArray"); }
+            std::vector<Numeric> & numberArray() final { throw TypeMismatch(Value::Type::Number, Value::Type::NumberArray, "numberArray"); }
             std::vector<std::string> & stringArray() final { throw TypeMismatch(Value::Type::Number, Value::Type::StringArray, "stringArray"); }
             std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() final {
                 throw TypeMismatch(Value::Type::Number, Value::Type::ObjectArray, "objectArray");
@@ -568,7 +889,7 @@ namespace Json
             
             const size_t & nullArray() const final { throw TypeMismatch(Value::Type::Number, Value::Type::NullArray, "nullArray"); }
             const std::vector<bool> & boolArray() const final { throw TypeMismatch(Value::Type::Number, Value::Type::BoolArray, "boolArray"); }
-            const std::vector<std::string> & numberArray() const final { throw TypeMismatch(Value::Type::Number, Value::Type::NumberArray, "numberArray"); }
+            const std::vector<Numeric> & numberArray() const final { throw TypeMismatch(Value::Type::Number, Value::Type::NumberArray, "numberArray"); }
             const std::vector<std::string> & stringArray() const final { throw TypeMismatch(Value::Type::Number, Value::Type::StringArray, "stringArray"); }
             const std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() const final {
                 throw TypeMismatch(Value::Type::Number, Value::Type::ObjectArray, "objectArray");
@@ -581,7 +902,7 @@ namespace Json
             }
             
         private:
-            std::string value;
+            Numeric value;
         };
         class String final : public Value {
         public:
@@ -595,7 +916,7 @@ namespace Json
             Type type() const final { return Value::Type::String; }
             
             bool & boolean() final { throw TypeMismatch(Value::Type::String, Value::Type::Boolean, "bool"); }
-            std::string & number() final { throw TypeMismatch(Value::Type::String, Value::Type::Number, "number"); }
+            Numeric & number() final { throw TypeMismatch(Value::Type::String, Value::Type::Number, "number"); }
             std::string & string() final { return value; }
             std::map<std::string, std::shared_ptr<Value>> & object() final { throw TypeMismatch(Value::Type::String, Value::Type::Object, "object"); }
             std::vector<std::pair<std::string, std::shared_ptr<Value>>> & orderedObject() final {
@@ -603,7 +924,7 @@ namespace Json
             }
 
             const bool & boolean() const final { throw TypeMismatch(Value::Type::String, Value::Type::Boolean, "bool"); }
-            const std::string & number() const final { throw TypeMismatch(Value::Type::String, Value::Type::Number, "number"); }
+            const Numeric & number() const final { throw TypeMismatch(Value::Type::String, Value::Type::Number, "number"); }
             const std::string & string() const final { return value; }
             const std::map<std::string, std::shared_ptr<Value>> & object() const final {
                 throw TypeMismatch(Value::Type::String, Value::Type::Object, "object");
@@ -616,7 +937,7 @@ namespace Json
             
             size_t & nullArray() final { throw TypeMismatch(Value::Type::String, Value::Type::NullArray, "nullArray"); }
             std::vector<bool> & boolArray() final { throw TypeMismatch(Value::Type::String, Value::Type::BoolArray, "boolArray"); }
-            std::vector<std::string> & numberArray() final { throw TypeMismatch(Value::Type::String, Value::Type::NumberArray, "numberArray"); }
+            std::vector<Numeric> & numberArray() final { throw TypeMismatch(Value::Type::String, Value::Type::NumberArray, "numberArray"); }
             std::vector<std::string> & stringArray() final { throw TypeMismatch(Value::Type::String, Value::Type::StringArray, "stringArray"); }
             std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() final {
                 throw TypeMismatch(Value::Type::String, Value::Type::ObjectArray, "objectArray");
@@ -628,7 +949,7 @@ namespace Json
             
             const size_t & nullArray() const final { throw TypeMismatch(Value::Type::String, Value::Type::NullArray, "nullArray"); }
             const std::vector<bool> & boolArray() const final { throw TypeMismatch(Value::Type::String, Value::Type::BoolArray, "boolArray"); }
-            const std::vector<std::string> & numberArray() const final { throw TypeMismatch(Value::Type::String, Value::Type::NumberArray, "numberArray"); }
+            const std::vector<Numeric> & numberArray() const final { throw TypeMismatch(Value::Type::String, Value::Type::NumberArray, "numberArray"); }
             const std::vector<std::string> & stringArray() const final { throw TypeMismatch(Value::Type::String, Value::Type::StringArray, "stringArray"); }
             const std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() const final {
                 throw TypeMismatch(Value::Type::String, Value::Type::ObjectArray, "objectArray");
@@ -656,7 +977,7 @@ namespace Json
             Type type() const override { return Value::Type::Object; }
             
             bool & boolean() final { throw TypeMismatch(Value::Type::Object, Value::Type::Boolean, "bool"); }
-            std::string & number() final { throw TypeMismatch(Value::Type::Object, Value::Type::Number, "number"); }
+            Numeric & number() final { throw TypeMismatch(Value::Type::Object, Value::Type::Number, "number"); }
             std::string & string() final { throw TypeMismatch(Value::Type::Object, Value::Type::String, "string"); }
             std::map<std::string, std::shared_ptr<Value>> & object() final { return value; }
             std::vector<std::pair<std::string, std::shared_ptr<Value>>> & orderedObject() final {
@@ -664,7 +985,7 @@ namespace Json
             }
             
             const bool & boolean() const final { throw TypeMismatch(Value::Type::Object, Value::Type::Boolean, "bool"); }
-            const std::string & number() const final { throw TypeMismatch(Value::Type::Object, Value::Type::Number, "number"); }
+            const Numeric & number() const final { throw TypeMismatch(Value::Type::Object, Value::Type::Number, "number"); }
             const std::string & string() const final { throw TypeMismatch(Value::Type::Object, Value::Type::String, "string"); }
             const std::map<std::string, std::shared_ptr<Value>> & object() const final { return value; }
             const std::vector<std::pair<std::string, std::shared_ptr<Value>>> & orderedObject() const final {
@@ -675,7 +996,7 @@ namespace Json
             
             size_t & nullArray() final { throw TypeMismatch(Value::Type::Object, Value::Type::NullArray, "nullArray"); }
             std::vector<bool> & boolArray() final { throw TypeMismatch(Value::Type::Object, Value::Type::BoolArray, "boolArray"); }
-            std::vector<std::string> & numberArray() final { throw TypeMismatch(Value::Type::Object, Value::Type::NumberArray, "numberArray"); }
+            std::vector<Numeric> & numberArray() final { throw TypeMismatch(Value::Type::Object, Value::Type::NumberArray, "numberArray"); }
             std::vector<std::string> & stringArray() final { throw TypeMismatch(Value::Type::Object, Value::Type::StringArray, "stringArray"); }
             std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() final {
                 throw TypeMismatch(Value::Type::Object, Value::Type::ObjectArray, "objectArray");
@@ -687,7 +1008,7 @@ namespace Json
             
             const size_t & nullArray() const final { throw TypeMismatch(Value::Type::Object, Value::Type::NullArray, "nullArray"); }
             const std::vector<bool> & boolArray() const final { throw TypeMismatch(Value::Type::Object, Value::Type::BoolArray, "boolArray"); }
-            const std::vector<std::string> & numberArray() const final { throw TypeMismatch(Value::Type::Object, Value::Type::NumberArray, "numberArray"); }
+            const std::vector<Numeric> & numberArray() const final { throw TypeMismatch(Value::Type::Object, Value::Type::NumberArray, "numberArray"); }
             const std::vector<std::string> & stringArray() const final { throw TypeMismatch(Value::Type::Object, Value::Type::StringArray, "stringArray"); }
             const std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() const final {
                 throw TypeMismatch(Value::Type::Object, Value::Type::ObjectArray, "objectArray");
@@ -720,13 +1041,13 @@ namespace Json
             Type type() const override { return Value::Type::OrderedObject; }
             
             bool & boolean() final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::Boolean, "bool"); }
-            std::string & number() final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::Number, "number"); }
+            Numeric & number() final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::Number, "number"); }
             std::string & string() final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::String, "string"); }
             std::map<std::string, std::shared_ptr<Value>> & object() final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::Object, "object"); }
             std::vector<std::pair<std::string, std::shared_ptr<Value>>> & orderedObject() final { return value; }
 
             const bool & boolean() const final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::Boolean, "bool"); }
-            const std::string & number() const final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::Number, "number"); }
+            const Numeric & number() const final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::Number, "number"); }
             const std::string & string() const final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::String, "string"); }
             const std::map<std::string, std::shared_ptr<Value>> & object() const final {
                 throw TypeMismatch(Value::Type::OrderedObject, Value::Type::Object, "object");
@@ -737,7 +1058,7 @@ namespace Json
             
             size_t & nullArray() final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::NullArray, "nullArray"); }
             std::vector<bool> & boolArray() final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::BoolArray, "boolArray"); }
-            std::vector<std::string> & numberArray() final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::NumberArray, "numberArray"); }
+            std::vector<Numeric> & numberArray() final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::NumberArray, "numberArray"); }
             std::vector<std::string> & stringArray() final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::StringArray, "stringArray"); }
             std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() final {
                 throw TypeMismatch(Value::Type::OrderedObject, Value::Type::ObjectArray, "objectArray");
@@ -749,7 +1070,7 @@ namespace Json
             
             const size_t & nullArray() const final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::NullArray, "nullArray"); }
             const std::vector<bool> & boolArray() const final { throw TypeMismatch(Value::Type::OrderedObject, Value::Type::BoolArray, "boolArray"); }
-            const std::vector<std::string> & numberArray() const final {
+            const std::vector<Numeric> & numberArray() const final {
                 throw TypeMismatch(Value::Type::OrderedObject, Value::Type::NumberArray, "numberArray");
             }
             const std::vector<std::string> & stringArray() const final {
@@ -785,7 +1106,7 @@ namespace Json
             Type type() const final { return Value::Type::NullArray; }
             
             bool & boolean() final { throw TypeMismatch(Value::Type::NullArray, Value::Type::Boolean, "bool"); }
-            std::string & number() final { throw TypeMismatch(Value::Type::NullArray, Value::Type::Number, "number"); }
+            Numeric & number() final { throw TypeMismatch(Value::Type::NullArray, Value::Type::Number, "number"); }
             std::string & string() final { throw TypeMismatch(Value::Type::NullArray, Value::Type::String, "string"); }
             std::map<std::string, std::shared_ptr<Value>> & object() final { throw TypeMismatch(Value::Type::NullArray, Value::Type::Object, "object"); }
             std::vector<std::pair<std::string, std::shared_ptr<Value>>> & orderedObject() final {
@@ -793,7 +1114,7 @@ namespace Json
             }
 
             const bool & boolean() const final { throw TypeMismatch(Value::Type::NullArray, Value::Type::Boolean, "bool"); }
-            const std::string & number() const final { throw TypeMismatch(Value::Type::NullArray, Value::Type::Number, "number"); }
+            const Numeric & number() const final { throw TypeMismatch(Value::Type::NullArray, Value::Type::Number, "number"); }
             const std::string & string() const final { throw TypeMismatch(Value::Type::NullArray, Value::Type::String, "string"); }
             const std::map<std::string, std::shared_ptr<Value>> & object() const final {
                 throw TypeMismatch(Value::Type::NullArray, Value::Type::Object, "object");
@@ -806,7 +1127,7 @@ namespace Json
             
             size_t & nullArray() final { return nullCount; }
             std::vector<bool> & boolArray() final { throw TypeMismatch(Value::Type::NullArray, Value::Type::BoolArray, "boolArray"); }
-            std::vector<std::string> & numberArray() final { throw TypeMismatch(Value::Type::NullArray, Value::Type::NumberArray, "numberArray"); }
+            std::vector<Numeric> & numberArray() final { throw TypeMismatch(Value::Type::NullArray, Value::Type::NumberArray, "numberArray"); }
             std::vector<std::string> & stringArray() final { throw TypeMismatch(Value::Type::NullArray, Value::Type::StringArray, "stringArray"); }
             std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() final {
                 throw TypeMismatch(Value::Type::NullArray, Value::Type::ObjectArray, "objectArray");
@@ -818,7 +1139,7 @@ namespace Json
             
             const size_t & nullArray() const final { return nullCount; }
             const std::vector<bool> & boolArray() const final { throw TypeMismatch(Value::Type::NullArray, Value::Type::BoolArray, "boolArray"); }
-            const std::vector<std::string> & numberArray() const final {
+            const std::vector<Numeric> & numberArray() const final {
                 throw TypeMismatch(Value::Type::NullArray, Value::Type::NumberArray, "numberArray");
             }
             const std::vector<std::string> & stringArray() const final {
@@ -849,7 +1170,7 @@ namespace Json
             Type type() const final { return Value::Type::BoolArray; }
             
             bool & boolean() final { throw TypeMismatch(Value::Type::BoolArray, Value::Type::Boolean, "bool"); }
-            std::string & number() final { throw TypeMismatch(Value::Type::BoolArray, Value::Type::Number, "number"); }
+            Numeric & number() final { throw TypeMismatch(Value::Type::BoolArray, Value::Type::Number, "number"); }
             std::string & string() final { throw TypeMismatch(Value::Type::BoolArray, Value::Type::String, "string"); }
             std::map<std::string, std::shared_ptr<Value>> & object() final { throw TypeMismatch(Value::Type::BoolArray, Value::Type::Object, "object"); }
             std::vector<std::pair<std::string, std::shared_ptr<Value>>> & orderedObject() final {
@@ -857,7 +1178,7 @@ namespace Json
             }
             
             const bool & boolean() const final { throw TypeMismatch(Value::Type::BoolArray, Value::Type::Boolean, "bool"); }
-            const std::string & number() const final { throw TypeMismatch(Value::Type::BoolArray, Value::Type::Number, "number"); }
+            const Numeric & number() const final { throw TypeMismatch(Value::Type::BoolArray, Value::Type::Number, "number"); }
             const std::string & string() const final { throw TypeMismatch(Value::Type::BoolArray, Value::Type::String, "string"); }
             const std::map<std::string, std::shared_ptr<Value>> & object() const final {
                 throw TypeMismatch(Value::Type::BoolArray, Value::Type::Object, "object");
@@ -870,7 +1191,7 @@ namespace Json
             
             size_t & nullArray() final { throw TypeMismatch(Value::Type::BoolArray, Value::Type::NullArray, "nullArray"); }
             std::vector<bool> & boolArray() final { return values; }
-            std::vector<std::string> & numberArray() final { throw TypeMismatch(Value::Type::BoolArray, Value::Type::NumberArray, "numberArray"); }
+            std::vector<Numeric> & numberArray() final { throw TypeMismatch(Value::Type::BoolArray, Value::Type::NumberArray, "numberArray"); }
             std::vector<std::string> & stringArray() final { throw TypeMismatch(Value::Type::BoolArray, Value::Type::StringArray, "stringArray"); }
             std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() final {
                 throw TypeMismatch(Value::Type::BoolArray, Value::Type::ObjectArray, "objectArray");
@@ -882,7 +1203,7 @@ namespace Json
             
             const size_t & nullArray() const final { throw TypeMismatch(Value::Type::BoolArray, Value::Type::NullArray, "nullArray"); }
             const std::vector<bool> & boolArray() const final { return values; }
-            const std::vector<std::string> & numberArray() const final {
+            const std::vector<Numeric> & numberArray() const final {
                 throw TypeMismatch(Value::Type::BoolArray, Value::Type::NumberArray, "numberArray");
             }
             const std::vector<std::string> & stringArray() const final {
@@ -904,7 +1225,8 @@ namespace Json
         class NumberArray final : public Value {
         public:
             NumberArray() : values() {}
-            NumberArray(const std::vector<std::string> & values) : values(values) {}
+            NumberArray(const std::vector<Numeric> & values) : values(values) {}
+            NumberArray(const std::vector<std::string> & values) : values(values.begin(), values.end()) {}
             NumberArray(const NumberArray & other) : values(other.values) {}
             
             NumberArray & operator=(const Value & other) { values = other.numberArray(); return *this; }
@@ -913,7 +1235,7 @@ namespace Json
             Type type() const final { return Value::Type::NumberArray; }
             
             bool & boolean() final { throw TypeMismatch(Value::Type::NumberArray, Value::Type::Boolean, "bool"); }
-            std::string & number() final { throw TypeMismatch(Value::Type::NumberArray, Value::Type::Number, "number"); }
+            Numeric & number() final { throw TypeMismatch(Value::Type::NumberArray, Value::Type::Number, "number"); }
             std::string & string() final { throw TypeMismatch(Value::Type::NumberArray, Value::Type::String, "string"); }
             std::map<std::string, std::shared_ptr<Value>> & object() final { throw TypeMismatch(Value::Type::NumberArray, Value::Type::Object, "object"); }
             std::vector<std::pair<std::string, std::shared_ptr<Value>>> & orderedObject() final {
@@ -921,7 +1243,7 @@ namespace Json
             }
             
             const bool & boolean() const final { throw TypeMismatch(Value::Type::NumberArray, Value::Type::Boolean, "bool"); }
-            const std::string & number() const final { throw TypeMismatch(Value::Type::NumberArray, Value::Type::Number, "number"); }
+            const Numeric & number() const final { throw TypeMismatch(Value::Type::NumberArray, Value::Type::Number, "number"); }
             const std::string & string() const final { throw TypeMismatch(Value::Type::NumberArray, Value::Type::String, "string"); }
             const std::map<std::string, std::shared_ptr<Value>> & object() const final {
                 throw TypeMismatch(Value::Type::NumberArray, Value::Type::Object, "object");
@@ -934,7 +1256,7 @@ namespace Json
             
             size_t & nullArray() final { throw TypeMismatch(Value::Type::NumberArray, Value::Type::NullArray, "nullArray"); }
             std::vector<bool> & boolArray() final { throw TypeMismatch(Value::Type::NumberArray, Value::Type::BoolArray, "boolArray"); }
-            std::vector<std::string> & numberArray() final { return values; }
+            std::vector<Numeric> & numberArray() final { return values; }
             std::vector<std::string> & stringArray() final { throw TypeMismatch(Value::Type::NumberArray, Value::Type::StringArray, "stringArray"); }
             std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() final {
                 throw TypeMismatch(Value::Type::NumberArray, Value::Type::ObjectArray, "objectArray");
@@ -946,7 +1268,7 @@ namespace Json
             
             const size_t & nullArray() const final { throw TypeMismatch(Value::Type::NumberArray, Value::Type::NullArray, "nullArray"); }
             const std::vector<bool> & boolArray() const final { throw TypeMismatch(Value::Type::NumberArray, Value::Type::BoolArray, "boolArray"); }
-            const std::vector<std::string> & numberArray() const final { return values; }
+            const std::vector<Numeric> & numberArray() const final { return values; }
             const std::vector<std::string> & stringArray() const final {
                 throw TypeMismatch(Value::Type::NumberArray, Value::Type::StringArray, "stringArray");
             }
@@ -961,7 +1283,7 @@ namespace Json
             }
             
         private:
-            std::vector<std::string> values;
+            std::vector<Numeric> values;
         };
         class StringArray final : public Value {
         public:
@@ -975,7 +1297,7 @@ namespace Json
             Type type() const final { return Value::Type::StringArray; }
             
             bool & boolean() final { throw TypeMismatch(Value::Type::StringArray, Value::Type::Boolean, "bool"); }
-            std::string & number() final { throw TypeMismatch(Value::Type::StringArray, Value::Type::Number, "number"); }
+            Numeric & number() final { throw TypeMismatch(Value::Type::StringArray, Value::Type::Number, "number"); }
             std::string & string() final { throw TypeMismatch(Value::Type::StringArray, Value::Type::String, "string"); }
             std::map<std::string, std::shared_ptr<Value>> & object() final { throw TypeMismatch(Value::Type::StringArray, Value::Type::Object, "object"); }
             std::vector<std::pair<std::string, std::shared_ptr<Value>>> & orderedObject() final {
@@ -983,7 +1305,7 @@ namespace Json
             }
             
             const bool & boolean() const final { throw TypeMismatch(Value::Type::StringArray, Value::Type::Boolean, "bool"); }
-            const std::string & number() const final { throw TypeMismatch(Value::Type::StringArray, Value::Type::Number, "number"); }
+            const Numeric & number() const final { throw TypeMismatch(Value::Type::StringArray, Value::Type::Number, "number"); }
             const std::string & string() const final { throw TypeMismatch(Value::Type::StringArray, Value::Type::String, "string"); }
             const std::map<std::string, std::shared_ptr<Value>> & object() const final {
                 throw TypeMismatch(Value::Type::StringArray, Value::Type::Object, "object");
@@ -996,7 +1318,7 @@ namespace Json
             
             size_t & nullArray() final { throw TypeMismatch(Value::Type::StringArray, Value::Type::NullArray, "nullArray"); }
             std::vector<bool> & boolArray() final { throw TypeMismatch(Value::Type::StringArray, Value::Type::BoolArray, "boolArray"); }
-            std::vector<std::string> & numberArray() final { throw TypeMismatch(Value::Type::StringArray, Value::Type::NumberArray, "numberArray"); }
+            std::vector<Numeric> & numberArray() final { throw TypeMismatch(Value::Type::StringArray, Value::Type::NumberArray, "numberArray"); }
             std::vector<std::string> & stringArray() final { return values; }
             std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() final {
                 throw TypeMismatch(Value::Type::StringArray, Value::Type::ObjectArray, "objectArray");
@@ -1008,7 +1330,7 @@ namespace Json
             
             const size_t & nullArray() const final { throw TypeMismatch(Value::Type::StringArray, Value::Type::NullArray, "nullArray"); }
             const std::vector<bool> & boolArray() const final { throw TypeMismatch(Value::Type::StringArray, Value::Type::BoolArray, "boolArray"); }
-            const std::vector<std::string> & numberArray() const final {
+            const std::vector<Numeric> & numberArray() const final {
                 throw TypeMismatch(Value::Type::StringArray, Value::Type::NumberArray, "numberArray");
             }
             const std::vector<std::string> & stringArray() const final { return values; }
@@ -1037,7 +1359,7 @@ namespace Json
             Type type() const final { return Value::Type::ObjectArray; }
             
             bool & boolean() final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::Boolean, "bool"); }
-            std::string & number() final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::Number, "number"); }
+            Numeric & number() final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::Number, "number"); }
             std::string & string() final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::String, "string"); }
             std::map<std::string, std::shared_ptr<Value>> & object() final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::Object, "object"); }
             std::vector<std::pair<std::string, std::shared_ptr<Value>>> & orderedObject() final {
@@ -1045,7 +1367,7 @@ namespace Json
             }
             
             const bool & boolean() const final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::Boolean, "bool"); }
-            const std::string & number() const final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::Number, "number"); }
+            const Numeric & number() const final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::Number, "number"); }
             const std::string & string() const final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::String, "string"); }
             const std::map<std::string, std::shared_ptr<Value>> & object() const final {
                 throw TypeMismatch(Value::Type::ObjectArray, Value::Type::Object, "object");
@@ -1058,7 +1380,7 @@ namespace Json
             
             size_t & nullArray() final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::NullArray, "nullArray"); }
             std::vector<bool> & boolArray() final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::BoolArray, "boolArray"); }
-            std::vector<std::string> & numberArray() final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::NumberArray, "numberArray"); }
+            std::vector<Numeric> & numberArray() final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::NumberArray, "numberArray"); }
             std::vector<std::string> & stringArray() final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::StringArray, "stringArray"); }
             std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() final { return values; }
             std::vector<std::vector<std::pair<std::string, std::shared_ptr<Value>>>> & orderedObjectArray() final {
@@ -1068,7 +1390,7 @@ namespace Json
             
             const size_t & nullArray() const final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::NullArray, "nullArray"); }
             const std::vector<bool> & boolArray() const final { throw TypeMismatch(Value::Type::ObjectArray, Value::Type::BoolArray, "boolArray"); }
-            const std::vector<std::string> & numberArray() const final {
+            const std::vector<Numeric> & numberArray() const final {
                 throw TypeMismatch(Value::Type::ObjectArray, Value::Type::NumberArray, "numberArray");
             }
             const std::vector<std::string> & stringArray() const final {
@@ -1098,7 +1420,7 @@ namespace Json
             Type type() const final { return Value::Type::OrderedObjectArray; }
             
             bool & boolean() final { throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::Boolean, "bool"); }
-            std::string & number() final { throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::Number, "number"); }
+            Numeric & number() final { throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::Number, "number"); }
             std::string & string() final { throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::String, "string"); }
             std::map<std::string, std::shared_ptr<Value>> & object() final {
                 throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::Object, "object");
@@ -1108,7 +1430,7 @@ namespace Json
             }
             
             const bool & boolean() const final { throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::Boolean, "bool"); }
-            const std::string & number() const final { throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::Number, "number"); }
+            const Numeric & number() const final { throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::Number, "number"); }
             const std::string & string() const final { throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::String, "string"); }
             const std::map<std::string, std::shared_ptr<Value>> & object() const final {
                 throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::Object, "object");
@@ -1121,7 +1443,7 @@ namespace Json
             
             size_t & nullArray() final { throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::NullArray, "nullArray"); }
             std::vector<bool> & boolArray() final { throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::BoolArray, "boolArray"); }
-            std::vector<std::string> & numberArray() final { throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::NumberArray, "numberArray"); }
+            std::vector<Numeric> & numberArray() final { throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::NumberArray, "numberArray"); }
             std::vector<std::string> & stringArray() final { throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::StringArray, "stringArray"); }
             std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() final {
                 throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::ObjectArray, "objectArray");
@@ -1133,7 +1455,7 @@ namespace Json
 
             const size_t & nullArray() const final { throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::NullArray, "nullArray"); }
             const std::vector<bool> & boolArray() const final { throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::BoolArray, "boolArray"); }
-            const std::vector<std::string> & numberArray() const final {
+            const std::vector<Numeric> & numberArray() const final {
                 throw TypeMismatch(Value::Type::OrderedObjectArray, Value::Type::NumberArray, "numberArray");
             }
             const std::vector<std::string> & stringArray() const final {
@@ -1162,7 +1484,7 @@ namespace Json
             Type type() const final { return Value::Type::MixedArray; }
             
             bool & boolean() final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::Boolean, "bool"); }
-            std::string & number() final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::Number, "number"); }
+            Numeric & number() final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::Number, "number"); }
             std::string & string() final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::String, "string"); }
             std::map<std::string, std::shared_ptr<Value>> & object() final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::Object, "object"); }
             std::vector<std::pair<std::string, std::shared_ptr<Value>>> & orderedObject() final {
@@ -1170,7 +1492,7 @@ namespace Json
             }
             
             const bool & boolean() const final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::Boolean, "bool"); }
-            const std::string & number() const final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::Number, "number"); }
+            const Numeric & number() const final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::Number, "number"); }
             const std::string & string() const final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::String, "string"); }
             const std::map<std::string, std::shared_ptr<Value>> & object() const final {
                 throw TypeMismatch(Value::Type::MixedArray, Value::Type::Object, "object");
@@ -1183,7 +1505,7 @@ namespace Json
             
             size_t & nullArray() final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::NullArray, "nullArray"); }
             std::vector<bool> & boolArray() final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::BoolArray, "boolArray"); }
-            std::vector<std::string> & numberArray() final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::NumberArray, "numberArray"); }
+            std::vector<Numeric> & numberArray() final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::NumberArray, "numberArray"); }
             std::vector<std::string> & stringArray() final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::StringArray, "stringArray"); }
             std::vector<std::map<std::string, std::shared_ptr<Value>>> & objectArray() final {
                 throw TypeMismatch(Value::Type::MixedArray, Value::Type::ObjectArray, "objectArray");
@@ -1195,7 +1517,7 @@ namespace Json
             
             const size_t & nullArray() const final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::NullArray, "nullArray"); }
             const std::vector<bool> & boolArray() const final { throw TypeMismatch(Value::Type::MixedArray, Value::Type::BoolArray, "boolArray"); }
-            const std::vector<std::string> & numberArray() const final {
+            const std::vector<Numeric> & numberArray() const final {
                 throw TypeMismatch(Value::Type::MixedArray, Value::Type::NumberArray, "numberArray");
             }
             const std::vector<std::string> & stringArray() const final {
@@ -1238,7 +1560,9 @@ namespace Json
         template <typename T> struct is_non_primitive<std::optional<T>> { static constexpr bool value = is_non_primitive<T>::value; };
         template <typename T> struct is_non_primitive<std::unique_ptr<T>> { static constexpr bool value = is_non_primitive<T>::value; };
         template <typename T> struct is_non_primitive<std::shared_ptr<T>> { static constexpr bool value = is_non_primitive<T>::value; };
-        template <> struct is_non_primitive<std::string> { static constexpr bool value = false; };
+        template <typename Allocator> struct is_non_primitive<std::basic_string<char, std::char_traits<char>, Allocator>> {
+            static constexpr bool value = false;
+        };
         template <> struct is_non_primitive<Json::Generic::Object> { static constexpr bool value = true; };
         template <> struct is_non_primitive<Json::Generic::OrderedObject> { static constexpr bool value = true; };
         template <> struct is_non_primitive<Json::Generic::NullArray> { static constexpr bool value = true; };
@@ -1251,6 +1575,13 @@ namespace Json
         template <> struct is_non_primitive<Json::Generic::FieldCluster> { static constexpr bool value = true; };
         template <typename T> inline constexpr bool is_non_primitive_v = is_non_primitive<T>::value;
 
+        template <typename T> struct is_string { static constexpr bool value = false; };
+        template <typename T> struct is_string<const T> { static constexpr bool value = is_string<T>::value; };
+        template <typename Allocator> struct is_string<std::basic_string<char, std::char_traits<char>, Allocator>> {
+            static constexpr bool value = true;
+        };
+        template <typename T> inline constexpr bool is_string_v = is_string<T>::value;
+
         template <size_t Index, typename ...Ts> struct is_non_primitive_tuple_element;
         template <typename ...Ts> struct is_non_primitive_tuple_element<0, std::tuple<Ts...>> { static constexpr bool value = false; };
         template <size_t Index, typename ...Ts> struct is_non_primitive_tuple_element<Index, std::tuple<Ts...>> {
@@ -1327,8 +1658,17 @@ namespace Json
             {
                 if constexpr ( IndentLevel > 0 && PrettyPrint )
                 {
+#ifdef USE_BUFFERED_STREAMS
+                    constexpr size_t indentSize = std::char_traits<char>::length(Indent);
+                    char* out = os.reserveRaw(IndentLevel*indentSize);
+                    for ( size_t i=0; i<IndentLevel; i++ )
+                        std::memcpy(out+i*indentSize, Indent, indentSize);
+
+                    os.commitRaw(IndentLevel*indentSize);
+#else
                     for ( size_t i=0; i<IndentLevel; i++ )
                         os << Indent;
+#endif
                 }
 
                 return os;
@@ -1461,8 +1801,17 @@ namespace Json
                 {
                     if constexpr ( PrettyPrint )
                     {
+#ifdef USE_BUFFERED_STREAMS
+                        constexpr size_t indentSize = std::char_traits<char>::length(Indent);
+                        char* out = os.reserveRaw(indentLevel*indentSize);
+                        for ( size_t i=0; i<indentLevel; i++ )
+                            std::memcpy(out+i*indentSize, Indent, indentSize);
+
+                        os.commitRaw(indentLevel*indentSize);
+#else
                         for ( size_t i=0; i<indentLevel; i++ )
                             os << Indent;
+#endif
                     }
                 }
                 
@@ -1735,8 +2084,29 @@ namespace Json
                     return false;
             }
 
-            inline void string(OutStreamType & os, const std::string & str)
+            inline void string(OutStreamType & os, std::string_view str)
             {
+#ifdef USE_BUFFERED_STREAMS
+                char* out = os.reserveRaw(2*str.size()+2); // Every char escapes to at most two chars
+                char* p = out;
+                *p++ = '\"';
+                for ( char c : str )
+                {
+                    switch ( c )
+                    {
+                    case '\"': *p++ = '\\'; *p++ = '\"'; break;
+                    case '\\': *p++ = '\\'; *p++ = '\\'; break;
+                    case '\b': *p++ = '\\'; *p++ = 'b'; break;
+                    case '\f': *p++ = '\\'; *p++ = 'f'; break;
+                    case '\n': *p++ = '\\'; *p++ = 'n'; break;
+                    case '\r': *p++ = '\\'; *p++ = 'r'; break;
+                    case '\t': *p++ = '\\'; *p++ = 't'; break;
+                    default: *p++ = c; break;
+                    }
+                }
+                *p++ = '\"';
+                os.commitRaw(size_t(p-out));
+#else
                 os << "\"";
                 for ( size_t i=0; i<str.size(); i++ )
                 {
@@ -1753,6 +2123,18 @@ namespace Json
                     }
                 }
                 os << "\"";
+#endif
+            }
+
+            template <typename Allocator>
+            inline void string(OutStreamType & os, const std::basic_string<char, std::char_traits<char>, Allocator> & str)
+            {
+                Put::string(os, std::string_view(str.data(), str.size()));
+            }
+
+            inline void string(OutStreamType & os, const char* str)
+            {
+                Put::string(os, std::string_view(str));
             }
 
             template <typename T>
@@ -1764,7 +2146,7 @@ namespace Json
                 std::stringstream ss;
 #endif
                 ss << t;
-                Put::string(os, ss.str());
+                Put::string(os, std::string(ss.str()));
             }
 
             template <typename Annotations, bool PrettyPrint, const char* Indent>
@@ -1795,7 +2177,7 @@ namespace Json
                         os << (value.boolean() ? "true" : "false");
                         break;
                     case Generic::Value::Type::Number:
-                        os << value.number();
+                        value.number().put(os);
                         break;
                     case Generic::Value::Type::String:
                         Put::string(os, value.string());
@@ -1912,11 +2294,11 @@ namespace Json
                     break;
                     case Generic::Value::Type::NumberArray:
                     {
-                        const std::vector<std::string> & array = iterable.numberArray();
+                        const std::vector<Numeric> & array = iterable.numberArray();
                         for ( const auto & element : array )
                         {
                             Put::separator<PrettyPrint, false, false, Indent>(os, 0 == i++, indentLevel+1);
-                            os << element;
+                            element.put(os);
                         }
                     }
                     break;
@@ -2052,7 +2434,7 @@ namespace Json
                 }
                 else if constexpr ( RareTs::is_pair_v<T> )
                     Put::pair<Annotations, Member, statics, PrettyPrint, IndentLevel, Indent, Object, IsFirst>(os, context, obj, value);
-                else if constexpr ( std::is_same_v<std::string, std::remove_const_t<T>> && !Member::template hasNote<Json::UnstringType>() )
+                else if constexpr ( is_string_v<T> && !Member::template hasNote<Json::UnstringType>() )
                     Put::string(os, value);
                 else if constexpr ( RareTs::is_iterable_v<T> )
                     Put::iterable<Annotations, Member, statics, PrettyPrint, IndentLevel, Indent>(os, context, obj, value);
@@ -2247,7 +2629,11 @@ namespace Json
                 {
                     constexpr bool IsFirst = !hasFields<statics, Object, false>() && SuperIndex == firstSuperIndex<statics, Object>();
                     os << StaticAffix::FieldPrefix<IsFirst, PrettyPrint, IndentLevel, Indent>;
-                    Put::string(os, superFieldName);
+                    if constexpr ( std::is_same_v<FieldName, SuperTypeJsonFieldName<T>> )
+                        os << superFieldName.quoted;
+                    else
+                        Put::string(os, superFieldName);
+
                     os << fieldNameValueSeparator<PrettyPrint>;
                     Put::object<Annotations, statics, PrettyPrint, IndentLevel, Indent, T>(os, context, obj);
                 }
@@ -2270,7 +2656,7 @@ namespace Json
                         else
                         {
                             Put::super<Annotations, decltype(superInfo)::index, Super, statics, PrettyPrint, IndentLevel, Indent, Object>(
-                                os, context, obj, superTypeToJsonFieldName<Super>());
+                                os, context, obj, superTypeJsonFieldName<Super>);
                         }
                     }
                 });
@@ -2395,6 +2781,169 @@ namespace Json
             Output::ReflectedObject<Annotations, statics, true, IndentLevel, Indent, T>(t, context).put(ss);
             return ss.str();
         }
+
+        class OutputBufferExceeded : public Exception
+        {
+        public:
+            OutputBufferExceeded() : Exception("Serialized output exceeded the size of the provided buffer!") {}
+        };
+
+#ifndef USE_BUFFERED_STREAMS
+        // Discards all output, counting the number of characters which would have been written
+        class CountingBuffer : public std::streambuf
+        {
+        public:
+            CountingBuffer() : count(0), scratch() { setp(&scratch[0], &scratch[0]+sizeof(scratch)); }
+
+            size_t size() const { return count + static_cast<size_t>(pptr() - pbase()); }
+
+        protected:
+            int_type overflow(int_type c) override
+            {
+                count += static_cast<size_t>(pptr() - pbase());
+                setp(&scratch[0], &scratch[0]+sizeof(scratch));
+                if ( !traits_type::eq_int_type(c, traits_type::eof()) )
+                    ++count;
+
+                return traits_type::not_eof(c);
+            }
+
+            std::streamsize xsputn(const char_type*, std::streamsize n) override
+            {
+                count += static_cast<size_t>(n);
+                return n;
+            }
+
+        private:
+            size_t count;
+            char scratch[256];
+        };
+
+        // Writes into a fixed-size caller-owned buffer, output beyond the end of the buffer fails the stream
+        class FixedBuffer : public std::streambuf
+        {
+        public:
+            FixedBuffer(char* begin, size_t size) { setp(begin, begin+size); }
+
+            size_t size() const { return static_cast<size_t>(pptr() - pbase()); }
+        };
+#else
+        inline constexpr size_t scratchHighWaterMark = 4096;
+
+        // Puts output through sb with a counting sink (output == nullptr) or a sink copying into output, returns the number of chars put
+        template <typename Put>
+        inline size_t putToSink(StringBuffer & sb, char* output, size_t capacity, Put && put)
+        {
+            if ( output == nullptr )
+                sb.attachCountingSink(scratchHighWaterMark);
+            else
+                sb.attachSink(output, capacity, scratchHighWaterMark);
+
+            try {
+                put(sb);
+                sb.detachSink();
+            } catch ( ... ) {
+                sb.detachSink();
+                sb.clear();
+                throw;
+            }
+            bool exceeded = sb.bad();
+            sb.clear();
+            if ( exceeded )
+                throw OutputBufferExceeded();
+
+            return sb.sinkWritten();
+        }
+
+        inline StringBuffer & scratchBuffer()
+        {
+            thread_local StringBuffer scratch {};
+            return scratch;
+        }
+
+        // Measuring and fixed writes go through a per-thread buffer which never grows past scratchHighWaterMark, so after a thread's first
+        // use neither allocates
+        template <typename Put>
+        inline size_t putToScratch(char* output, size_t capacity, Put && put)
+        {
+            StringBuffer & scratch = scratchBuffer();
+            if ( scratch.sinkAttached() ) // Nested use (e.g. measuring from within a customizer), use a buffer of its own
+            {
+                StringBuffer sb {};
+                return putToSink(sb, output, capacity, std::forward<Put>(put));
+            }
+            return putToSink(scratch, output, capacity, std::forward<Put>(put));
+        }
+#endif
+
+        template <typename Annotations, Statics statics, bool PrettyPrint, size_t IndentLevel, const char* Indent, typename T>
+        inline size_t measureOutput(const T & t, std::shared_ptr<Context> context)
+        {
+            #ifdef USE_BUFFERED_STREAMS
+            return putToScratch(nullptr, 0, [&](StringBuffer & sb) {
+                Output::ReflectedObject<Annotations, statics, PrettyPrint, IndentLevel, Indent, T>(t, context).put(sb);
+            });
+            #else
+            CountingBuffer counter;
+            std::ostream os(&counter);
+            Output::ReflectedObject<Annotations, statics, PrettyPrint, IndentLevel, Indent, T>(t, context).put(os);
+            return counter.size();
+            #endif
+        }
+
+        template <typename Annotations, Statics statics, bool PrettyPrint, size_t IndentLevel, const char* Indent, typename T>
+        inline size_t writeFixed(const T & t, char* output, size_t capacity, std::shared_ptr<Context> context)
+        {
+            #ifdef USE_BUFFERED_STREAMS
+            char empty = '\0'; // A non-null output, so an empty span is not taken for measuring
+            return putToScratch(output != nullptr ? output : &empty, capacity, [&](StringBuffer & sb) {
+                Output::ReflectedObject<Annotations, statics, PrettyPrint, IndentLevel, Indent, T>(t, context).put(sb);
+            });
+            #else
+            FixedBuffer buffer(output, capacity);
+            std::ostream os(&buffer);
+            Output::ReflectedObject<Annotations, statics, PrettyPrint, IndentLevel, Indent, T>(t, context).put(os);
+            if ( os.fail() )
+                throw OutputBufferExceeded();
+            return buffer.size();
+            #endif
+        }
+
+        // Gets the exact number of characters Json::write would produce for t, without retaining the output
+        template <Statics statics = Statics::Excluded, typename Annotations = RareTs::NoNote,
+            size_t IndentLevel = 0, const char* Indent = twoSpaces, typename T = uint_least8_t>
+        inline size_t measure(const T & t, std::shared_ptr<Context> context = nullptr)
+        {
+            return Output::measureOutput<Annotations, statics, false, IndentLevel, Indent, T>(t, context);
+        }
+
+        // Gets the exact number of characters Json::writePretty would produce for t, without retaining the output
+        template <Statics statics = Statics::Excluded, typename Annotations = RareTs::NoNote,
+            size_t IndentLevel = 0, const char* Indent = twoSpaces, typename T = uint_least8_t>
+        inline size_t measurePretty(const T & t, std::shared_ptr<Context> context = nullptr)
+        {
+            return Output::measureOutput<Annotations, statics, true, IndentLevel, Indent, T>(t, context);
+        }
+
+#ifndef RARE_NO_CPP_20
+        // Writes t into the caller-provided output buffer (without a nul-terminator), returns the number of characters written
+        // Throws OutputBufferExceeded if the output does not fit, the size needed can be obtained up-front using Json::measure
+        template <Statics statics = Statics::Excluded, typename Annotations = RareTs::NoNote,
+            size_t IndentLevel = 0, const char* Indent = twoSpaces, typename T = uint_least8_t>
+        inline size_t write(const T & t, std::span<char> output, std::shared_ptr<Context> context = nullptr)
+        {
+            return Output::writeFixed<Annotations, statics, false, IndentLevel, Indent, T>(t, output.data(), output.size(), context);
+        }
+
+        // Pretty-writes t into the caller-provided output buffer (without a nul-terminator), returns the number of characters written
+        // Throws OutputBufferExceeded if the output does not fit, the size needed can be obtained up-front using Json::measurePretty
+        template <Statics statics = Statics::Excluded, typename Annotations = RareTs::NoNote,
+            size_t IndentLevel = 0, const char* Indent = twoSpaces, typename T = uint_least8_t>
+        inline size_t writePretty(const T & t, std::span<char> output, std::shared_ptr<Context> context = nullptr)
+        {
+            return Output::writeFixed<Annotations, statics, true, IndentLevel, Indent, T>(t, output.data(), output.size(), context);
+        }
+#endif
     }
     
     inline namespace Input
@@ -2500,11 +3049,18 @@ namespace Json
             public:
                 ArraySizeExceeded() : Exception("Array size exceeded!") {}
             };
+
+            class UnexpectedTrailingCharacter : public Exception
+            {
+            public:
+                UnexpectedTrailingCharacter(char c)
+                    : Exception((std::string("Unexpected character after value: \"") + c + "\" expected: whitespace or end of input").c_str()) {}
+            };
         }
 
         inline namespace Cache
         {
-            inline std::hash<std::string> strHash;
+            inline std::hash<std::string_view> strHash;
 
             inline std::map<std::type_index, std::multimap<size_t, JsonField>> classToNameHashToJsonField;
             
@@ -2530,9 +3086,8 @@ namespace Json
                                 using Member = std::remove_reference_t<decltype(member)>;
                                 if constexpr ( std::is_base_of_v<Generic::FieldCluster, RareTs::remove_pointer_t<typename Member::type>> )
                                 {
-                                    std::string fieldName = fieldClusterToJsonFieldName();
-                                    inserted.first->second.insert(std::pair<size_t, JsonField>(
-                                        strHash(fieldName), JsonField(memberIndex, JsonField::Type::FieldCluster, fieldName)));
+                                    inserted.first->second.insert(std::pair<size_t, JsonField>(strHash(fieldClusterJsonFieldName),
+                                        JsonField(memberIndex, JsonField::Type::FieldCluster, std::string(fieldClusterJsonFieldName))));
                                 }
                                 else if constexpr ( !Member::template hasNote<Json::IgnoreType>() )
                                 {
@@ -2570,9 +3125,9 @@ namespace Json
                                 }
                                 else
                                 {
-                                    std::string superTypeFieldName = superTypeToJsonFieldName<Super>();
-                                    inserted.first->second.insert(std::pair<size_t, JsonField>(
-                                        strHash(superTypeFieldName), JsonField(decltype(I)::value, JsonField::Type::SuperClass, superTypeFieldName)));
+                                    constexpr std::string_view superTypeFieldName = superTypeJsonFieldName<Super>.view();
+                                    inserted.first->second.insert(std::pair<size_t, JsonField>(strHash(superTypeFieldName),
+                                        JsonField(decltype(I)::value, JsonField::Type::SuperClass, std::string(superTypeFieldName))));
                                 }
                             }
                         });
@@ -2584,7 +3139,7 @@ namespace Json
             }
             
             template <typename T>
-            inline JsonField* getJsonField(const std::string & fieldName)
+            inline JsonField* getJsonField(std::string_view fieldName)
             {
                 std::multimap<size_t, JsonField> & fieldNameToJsonField = getClassFieldCache<T>();
                 size_t fieldNameHash = strHash(fieldName);
@@ -2597,6 +3152,49 @@ namespace Json
                 return nullptr;
             }
 
+            template <typename Member, typename = RareTs::enable_if_member_t<Member>>
+            struct IsOrderedField : std::bool_constant<Member::isData && !Member::isStatic && !Member::template hasNote<Json::IgnoreType>() &&
+                !std::is_base_of_v<Generic::FieldCluster, RareTs::remove_pointer_t<typename Member::type>>> {};
+
+            // The names and member indexes of regular fields in the order Json::out writes them, used to predict the next field while reading
+            template <typename T>
+            struct FieldOrder
+            {
+                static constexpr size_t total = Reflect<T>::Members::template filteredCount<IsOrderedField>();
+
+                static constexpr std::array<std::string_view, total> names = [](){
+                    std::array<std::string_view, total> result {};
+                    size_t i = 0;
+                    Reflect<T>::Members::template forEach<IsOrderedField>([&](auto & member) {
+                        using Member = std::remove_reference_t<decltype(member)>;
+                        if constexpr ( Member::template hasNote<Json::Name>() )
+                            result[i++] = Member::template getNote<Json::Name>().value;
+                        else
+                            result[i++] = Member::name;
+                    });
+                    return result;
+                }();
+
+                static constexpr std::array<size_t, total> indexes = [](){
+                    std::array<size_t, total> result {};
+                    size_t i = 0;
+                    Reflect<T>::Members::template forEach<IsOrderedField>([&](auto & member) {
+                        result[i++] = std::remove_reference_t<decltype(member)>::index;
+                    });
+                    return result;
+                }();
+
+                // The position of each member index in names, or total for members which aren't ordered fields
+                static constexpr std::array<size_t, Reflect<T>::Members::total> positions = [](){
+                    std::array<size_t, Reflect<T>::Members::total> result {};
+                    for ( auto & position : result )
+                        position = total;
+                    for ( size_t i=0; i<total; ++i )
+                        result[indexes[i]] = i;
+                    return result;
+                }();
+            };
+
             inline void putClassFieldCache(std::ostream & os)
             {
                 os << "{" << std::endl;
@@ -3409,9 +4007,16 @@ namespace Json
                 return ss.str();
             }
 
-            template <bool ExpectQuotes = true>
-            inline void string(std::istream & is, char & c, std::stringstream & ss)
+            // Reads a string value, appending the unescaped characters to out (a std::ostream or any container with push_back)
+            template <bool ExpectQuotes = true, typename Out = std::stringstream>
+            inline void appendString(std::istream & is, char & c, Out & out)
             {
+                const auto put = [&out](char ch) {
+                    if constexpr ( std::is_base_of_v<std::ostream, Out> )
+                        out.put(ch);
+                    else
+                        out.push_back(ch);
+                };
                 if constexpr ( ExpectQuotes )
                     Checked::get(is, c, '\"', "string value open quote");
                 do
@@ -3427,14 +4032,14 @@ namespace Json
                             Checked::get<false>(is, c, "completion of string escape sequence");
                             switch ( c )
                             {
-                                case '\"': ss.put('\"'); c = '\0'; break;
-                                case '\\': ss.put('\\'); break;
-                                case '/': ss.put('/'); break;
-                                case 'b': ss.put('\b'); break;
-                                case 'f': ss.put('\f'); break;
-                                case 'n': ss.put('\n'); break;
-                                case 'r': ss.put('\r'); break;
-                                case 't': ss.put('\t'); break;
+                                case '\"': put('\"'); c = '\0'; break;
+                                case '\\': put('\\'); break;
+                                case '/': put('/'); break;
+                                case 'b': put('\b'); break;
+                                case 'f': put('\f'); break;
+                                case 'n': put('\n'); break;
+                                case 'r': put('\r'); break;
+                                case 't': put('\t'); break;
                                 case 'u':
                                 {
                                     char hexEscapeSequence[6] = { 'u', '\0', '\0', '\0', '\0', '\0' };
@@ -3458,9 +4063,9 @@ namespace Json
                                     char highCharacter = char(0x10 * hexEscapeSequence[1] + hexEscapeSequence[2]);
                                     char lowCharacter = char(0x10 * hexEscapeSequence[3] + hexEscapeSequence[4]);
                                     if ( highCharacter > 0 )
-                                        ss.put(highCharacter);
+                                        put(highCharacter);
 
-                                    ss.put(lowCharacter);
+                                    put(lowCharacter);
                                 }
                                 break;
                             }
@@ -3468,29 +4073,37 @@ namespace Json
                         case '\n': throw UnexpectedLineEnding("\\n");
                         case '\r': throw UnexpectedLineEnding("\\r");
                         case '\"': break; // Closing quote
-                        default: ss.put(c); break;
+                        default: put(c); break;
                     }
                 } while ( c != '\"' && !is.eof() );
             }
 
             template <bool ExpectQuotes = true>
-            inline void string(std::istream & is, char & c, std::string & str)
+            inline void string(std::istream & is, char & c, std::stringstream & ss)
             {
-                std::stringstream ss;
-                Read::string<ExpectQuotes>(is, c, ss);
-                str = ss.str();
+                Read::appendString<ExpectQuotes>(is, c, ss);
+            }
+
+            template <bool ExpectQuotes = true, typename Allocator = std::allocator<char>>
+            inline void string(std::istream & is, char & c, std::basic_string<char, std::char_traits<char>, Allocator> & str)
+            {
+                str.clear();
+                Read::appendString<ExpectQuotes>(is, c, str);
             }
 
             template <typename T, bool ExpectQuotes = true>
             inline void string(std::istream & is, char & c, T & t)
             {
-                std::stringstream ss;
-                Read::string<ExpectQuotes>(is, c, ss);
-                if constexpr ( !std::is_const_v<T> )
+                if constexpr ( !std::is_const_v<T> && RareTs::is_specialization_v<RareTs::remove_cvref_t<T>, std::basic_string> )
                 {
-                    if constexpr ( std::is_same_v<RareTs::remove_cvref_t<T>, std::string> )
-                        t.assign(std::istreambuf_iterator<char>(ss), {});
-                    else
+                    t.clear();
+                    Read::appendString<ExpectQuotes>(is, c, t);
+                }
+                else
+                {
+                    std::stringstream ss;
+                    Read::string<ExpectQuotes>(is, c, ss);
+                    if constexpr ( !std::is_const_v<T> )
                         ss >> t;
                 }
             }
@@ -3530,14 +4143,20 @@ namespace Json
                 value = Value(temp);
             }
             
-            inline std::string fieldName(std::istream & is, char & c)
+            template <typename Allocator>
+            inline void fieldName(std::istream & is, char & c, std::basic_string<char, std::char_traits<char>, Allocator> & fieldName)
             {
-                std::string fieldName;
                 try {
                     Read::string<>(is, c, fieldName);
                 } catch ( UnexpectedLineEnding & e) {
                     throw FieldNameUnexpectedLineEnding(e);
                 }
+            }
+
+            inline std::string fieldName(std::istream & is, char & c)
+            {
+                std::string fieldName;
+                Read::fieldName(is, c, fieldName);
                 return fieldName;
             }
 
@@ -3647,7 +4266,7 @@ namespace Json
                             break;
                             case Generic::Value::Type::Number:
                             {
-                                const std::vector<std::string> & numberArray = result->get()->numberArray();
+                                const std::vector<Numeric> & numberArray = result->get()->numberArray();
                                 for ( size_t i=0; i<numberArray.size(); i++ )
                                     mixedArray.push_back(std::make_shared<Generic::Number>(numberArray[i]));
                             }
@@ -3905,7 +4524,7 @@ namespace Json
                 }
                 else if constexpr ( RareTs::is_pair_v<T> )
                     Read::pair<Annotations, Member>(is, context, c, object, value);
-                else if constexpr ( std::is_same_v<std::string, std::remove_const_t<T>> && !Member::template hasNote<Json::UnstringType>() )
+                else if constexpr ( is_string_v<T> && !Member::template hasNote<Json::UnstringType>() )
                     Read::string<T, ExpectQuotes>(is, c, value);
                 else if constexpr ( RareTs::is_iterable_v<T> )
                     Read::iterable<Annotations, Member, T>(is, context, c, object, value);
@@ -3982,7 +4601,8 @@ namespace Json
                 {
                     do
                     {
-                        std::string fieldName = Read::fieldName(is, c);
+                        std::pmr::string fieldName(context.memory);
+                        Read::fieldName(is, c, fieldName);
                         Read::fieldNameValueSeparator(is, c);
                         if ( fieldName.compare("key") == 0 )
                             Read::value<Annotations, false, Member>(is, context, c, object, value.first);
@@ -4074,8 +4694,9 @@ namespace Json
                 }
             }
 
+            // Reads the value of the named field, returns the known field it was read into (or nullptr if the field was unknown)
             template <typename OpNotes = RareTs::NoNote, typename Object = void>
-            constexpr void field(std::istream & is, Context & context, char & c, Object & object, const std::string & fieldName)
+            constexpr const JsonField* field(std::istream & is, Context & context, char & c, Object & object, std::string_view fieldName)
             {
                 Read::fieldNameValueSeparator(is, c);
                 JsonField* jsonField = getJsonField<Object>(fieldName);
@@ -4095,10 +4716,11 @@ namespace Json
                             Read::object<OpNotes, Super>(is, context, c, superObj);
                         });
                     }
+                    return jsonField;
                 }
                 else // Unknown field
                 {
-                    jsonField = getJsonField<Object>(fieldClusterToJsonFieldName());
+                    jsonField = getJsonField<Object>(fieldClusterJsonFieldName);
                     if ( jsonField != nullptr ) // Has FieldCluster
                     {
                         Reflect<Object>::Values::at(jsonField->index, object, [&](auto & value) {
@@ -4118,10 +4740,10 @@ namespace Json
                                             "Cannot assign a non-null value to a null pointer unless the type is std::shared_ptr or std::unique_ptr");
                                     }
 
-                                    value->put(fieldName, Read::genericValue<false, OpAnnotations<OpNotes>::template hasNote<OrderObjectsType>()>(is, context, c)->out());
+                                    value->put(std::string(fieldName), Read::genericValue<false, OpAnnotations<OpNotes>::template hasNote<OrderObjectsType>()>(is, context, c)->out());
                                 }
                                 else
-                                    value.put(fieldName, Read::genericValue<false, OpAnnotations<OpNotes>::template hasNote<OrderObjectsType>()>(is, context, c)->out());
+                                    value.put(std::string(fieldName), Read::genericValue<false, OpAnnotations<OpNotes>::template hasNote<OrderObjectsType>()>(is, context, c)->out());
                             }
                             else
                                 throw Exception(std::string(RareTs::toStr<ValueType>()).c_str());
@@ -4130,6 +4752,7 @@ namespace Json
                     else // No FieldCluster
                         Consume::value<false>(is, c);
                 }
+                return nullptr;
             }
 
             template <typename Annotations, typename T>
@@ -4138,10 +4761,30 @@ namespace Json
                 Read::objectPrefix(is, c);
                 if ( !Read::tryObjectSuffix(is) )
                 {
+                    size_t expected = 0; // Predict fields arrive in declaration order (as they do from Json::out), checked before the hashed lookup
+                    std::pmr::string fieldName(context.memory); // Reused for each field of the object
                     do
                     {
-                        std::string fieldName = Read::fieldName(is, c);
-                        Read::field<Annotations>(is, context, c, t, fieldName);
+                        Read::fieldName(is, c, fieldName);
+                        if constexpr ( FieldOrder<T>::total > 0 )
+                        {
+                            if ( expected < FieldOrder<T>::total && FieldOrder<T>::names[expected] == fieldName )
+                            {
+                                Read::fieldNameValueSeparator(is, c);
+                                Reflect<T>::Members::template at<IsOrderedField>(FieldOrder<T>::indexes[expected], t, [&](auto & member, auto & value) {
+                                    using Member = std::remove_reference_t<decltype(member)>;
+                                    Read::value<Annotations, false, Member>(is, context, c, t, value);
+                                });
+                                ++expected;
+                                continue;
+                            }
+                        }
+                        const JsonField* jsonField = Read::field<Annotations>(is, context, c, t, fieldName);
+                        if constexpr ( FieldOrder<T>::total > 0 )
+                        { // Resume predicting from the field after the one found by the hashed lookup
+                            if ( jsonField != nullptr && jsonField->type == JsonField::Type::Regular )
+                                expected = FieldOrder<T>::positions[jsonField->index]+1;
+                        }
                     }
                     while ( Read::fieldSeparator(is) );
                 }
@@ -4180,22 +4823,281 @@ namespace Json
             return Input::ReflectedObject<Annotations, T>(t, context);
         }
 
+        // Reads from input in place (e.g. a std::string, or the view of a RareBufferedStream::MappedFile) without copying it into a stream
         template <typename Annotations = RareTs::NoNote, typename T = void>
-        inline void read(const std::string & input, T & t, std::shared_ptr<Context> context = nullptr)
+        inline void read(std::string_view input, T & t, std::shared_ptr<Context> context = nullptr)
         {
-            std::stringstream ss {input};
-            Input::ReflectedObject<Annotations, T>(t, context).get(ss);
+            RareBufferedStream::ViewStringBuffer is(input);
+            Input::ReflectedObject<Annotations, T>(t, context).get(is);
         }
 
         template <typename T = void, typename Annotations = RareTs::NoNote>
-        inline T read(const std::string & input, std::shared_ptr<Context> context = nullptr)
+        inline T read(std::string_view input, std::shared_ptr<Context> context = nullptr)
         {
-            std::stringstream ss {input};
+            RareBufferedStream::ViewStringBuffer is(input);
             T t {};
-            Input::ReflectedObject<Annotations, T>(t, context).get(ss);
+            Input::ReflectedObject<Annotations, T>(t, context).get(is);
             return t;
         }
 
+        // Calls function(fieldName, value) for each field of the JSON object in input without reading the values; the object is validated
+        // as it's read (values are consumed by the same rules used to skip unknown fields), values are views into input which remain JSON
+        template <typename Function>
+        inline void readFields(std::string_view input, Function && function)
+        {
+            RareBufferedStream::ViewStringBuffer is(input);
+            char c = '\0';
+            Checked::consumeWhitespace(is, "object opening \"{\"");
+            Read::objectPrefix(is, c);
+            if ( !Read::tryObjectSuffix(is) )
+            {
+                std::string fieldName {}; // Reused for each field of the object
+                do
+                {
+                    Read::fieldName(is, c, fieldName);
+                    Read::fieldNameValueSeparator(is, c);
+                    Checked::consumeWhitespace(is, "completion of field value");
+                    size_t valueStart = input.size() - is.remaining().size();
+                    Consume::value<false>(is, c);
+                    std::string_view value = input.substr(valueStart, input.size() - is.remaining().size() - valueStart);
+                    function(std::string_view(fieldName), value.substr(0, value.find_last_not_of(" \t\r\n")+1));
+                }
+                while ( Read::fieldSeparator(is) );
+            }
+            is >> std::ws;
+            if ( is.get(c) )
+                throw UnexpectedTrailingCharacter(c);
+        }
+
+        // Accepts JSON in arbitrarily sized chunks (e.g. as they arrive from a socket) and reads each complete top-level value as soon as
+        // its final character arrives; the structure of the value in progress is tracked explicitly between chunks, complete values are read
+        // through Read::value in place: a value within one chunk is read from that chunk, a value spanning chunks is read from the chars
+        // retained from earlier chunks (which are the only chars copied, as the caller's chunks needn't outlive feed) followed by the
+        // remainder of the value in the final chunk
+        // Top-level values may be separated by whitespace; a top-level number or literal is only known to be complete once followed by
+        // whitespace, another value, or a call to finish(); if reading a value throws, that value is discarded and the rest of the chunk
+        // is kept and scanned at the start of the next feed() or finish()
+        template <typename T, typename Annotations = RareTs::NoNote>
+        class PushParser
+        {
+        public:
+            PushParser(std::shared_ptr<Context> context = nullptr) : context(context) {}
+
+            // Feeds the next chunk of input, returns the number of complete values available from next()
+            size_t feed(std::string_view chunk)
+            {
+                if ( !unconsumed.empty() ) // Remainder of a chunk in which reading a value threw
+                {
+                    std::string tail {};
+                    tail.swap(unconsumed);
+                    try {
+                        scan(tail);
+                    } catch ( ... ) {
+                        unconsumed.append(chunk);
+                        throw;
+                    }
+                }
+                scan(chunk);
+                return values.size();
+            }
+
+            // Signals the end of input, completing any top-level number or literal in progress
+            // Throws UnexpectedInputEnd if an object, array or string is incomplete
+            size_t finish()
+            {
+                if ( !unconsumed.empty() )
+                    feed(std::string_view{});
+
+                if ( state == State::Primitive )
+                    complete(std::string_view{}, std::string_view::npos, 0, 0);
+                else if ( state != State::None )
+                {
+                    reset();
+                    throw UnexpectedInputEnd(depth > 0 ? "completion of object or array" : "string close quote");
+                }
+                return values.size();
+            }
+
+            bool ready() const { return !values.empty(); }
+
+            size_t available() const { return values.size(); }
+
+            // Takes the earliest complete value, ready() must be true
+            T next()
+            {
+                T t = std::move(values.front());
+                values.pop_front();
+                return t;
+            }
+
+            // Discards the value in progress as well as any complete values not yet taken
+            void reset()
+            {
+                state = State::None;
+                depth = 0;
+                pending.clear();
+                unconsumed.clear();
+                values.clear();
+            }
+
+        private:
+            enum class State { None, Primitive, String, StringEscape, Nested };
+
+            // Reads the chars retained from earlier chunks followed by the rest of a value in the current chunk, without joining them
+            class SpanningBuffer : public std::streambuf
+            {
+            public:
+                SpanningBuffer(std::string_view retained, std::string_view rest) : retained(retained), rest(rest) { setg(retained); }
+
+            protected:
+                int_type underflow() override
+                {
+                    if ( eback() == retained.data() && !rest.empty() )
+                    {
+                        setg(rest);
+                        return traits_type::to_int_type(*gptr());
+                    }
+                    return traits_type::eof();
+                }
+
+                int_type pbackfail(int_type c) override
+                {
+                    if ( eback() == rest.data() && gptr() == eback() && !retained.empty() &&
+                        (traits_type::eq_int_type(c, traits_type::eof()) || traits_type::eq_int_type(c, traits_type::to_int_type(retained.back()))) )
+                    {
+                        setg(retained, retained.size()-1); // Back to the last retained char
+                        return traits_type::not_eof(c);
+                    }
+                    return traits_type::eof();
+                }
+
+            private:
+                void setg(std::string_view view, size_t offset = 0)
+                {
+                    char* begin = const_cast<char*>(view.data()); // The get area is never written to
+                    std::streambuf::setg(begin, begin+offset, begin+view.size());
+                }
+
+                std::string_view retained;
+                std::string_view rest;
+            };
+
+            void scan(std::string_view chunk)
+            {
+                size_t valueStart = state == State::None ? std::string_view::npos : 0;
+                for ( size_t i=0; i<chunk.size(); ++i )
+                {
+                    char c = chunk[i];
+                    switch ( state )
+                    {
+                        case State::None:
+                            if ( begin(c) )
+                                valueStart = i;
+                            break;
+                        case State::Primitive:
+                            if ( std::isspace(static_cast<unsigned char>(c)) || c == '{' || c == '[' || c == '\"' )
+                            {
+                                complete(chunk, valueStart, i, i);
+                                valueStart = begin(c) ? i : std::string_view::npos;
+                            }
+                            break;
+                        case State::String:
+                            if ( c == '\\' )
+                                state = State::StringEscape;
+                            else if ( c == '\"' )
+                            {
+                                if ( depth == 0 )
+                                {
+                                    complete(chunk, valueStart, i+1, i+1);
+                                    valueStart = std::string_view::npos;
+                                }
+                                else
+                                    state = State::Nested;
+                            }
+                            break;
+                        case State::StringEscape:
+                            state = State::String;
+                            break;
+                        case State::Nested:
+                            if ( c == '\"' )
+                                state = State::String;
+                            else if ( c == '{' || c == '[' )
+                                ++depth;
+                            else if ( (c == '}' || c == ']') && --depth == 0 )
+                            {
+                                complete(chunk, valueStart, i+1, i+1);
+                                valueStart = std::string_view::npos;
+                            }
+                            break;
+                    }
+                }
+                if ( valueStart != std::string_view::npos )
+                    pending.append(chunk.data()+valueStart, chunk.size()-valueStart);
+            }
+
+            bool begin(char c)
+            {
+                if ( c == '{' || c == '[' )
+                {
+                    state = State::Nested;
+                    depth = 1;
+                }
+                else if ( c == '\"' )
+                    state = State::String;
+                else if ( !std::isspace(static_cast<unsigned char>(c)) )
+                    state = State::Primitive;
+
+                return state != State::None;
+            }
+
+            // Reads the value ending at valueEnd, chars from scanFrom onwards are kept for the next feed or finish if reading throws
+            void complete(std::string_view chunk, size_t valueStart, size_t valueEnd, size_t scanFrom)
+            {
+                state = State::None;
+                depth = 0;
+                try {
+                    if ( pending.empty() ) // Value is entirely within the current chunk
+                    {
+                        RareBufferedStream::ViewStringBuffer is(chunk.substr(valueStart, valueEnd-valueStart));
+                        read(is);
+                    }
+                    else
+                    {
+                        SpanningBuffer buffer(pending, chunk.substr(0, valueEnd));
+                        std::istream is(&buffer);
+                        read(is);
+                        pending.clear();
+                    }
+                } catch ( ... ) {
+                    pending.clear();
+                    unconsumed.assign(chunk.substr(std::min(scanFrom, chunk.size())));
+                    throw;
+                }
+            }
+
+            void read(std::istream & is)
+            {
+                if ( context == nullptr )
+                    context = std::make_shared<Context>();
+
+                T t {};
+                Input::ReflectedObject<Annotations, T>(t, context).get(is);
+                for ( char c = '\0'; is.get(c); )
+                {
+                    if ( !std::isspace(static_cast<unsigned char>(c)) ) // e.g. "1234abc"
+                        throw UnexpectedTrailingCharacter(c);
+                }
+                values.push_back(std::move(t));
+            }
+
+            std::shared_ptr<Context> context;
+            State state = State::None;
+            size_t depth = 0;
+            std::string pending {}; // Chars of the value in progress retained from earlier chunks
+            std::string unconsumed {}; // Chars after a value which threw while being read, scanned before the next chunk
+            std::deque<T> values {};
+        };
+
 
     }
 
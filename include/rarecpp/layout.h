@@ -0,0 +1,146 @@
+// MIT License, Copyright (c) 2019-2025 Justin F https://github.com/TheNitesWhoSay/RareCpp/blob/master/LICENSE
+#ifndef LAYOUT_H
+#define LAYOUT_H
+#ifndef REFLECT_H
+#include "reflect.h"
+#endif
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Compile-time memory layout analysis of REFLECT-ed types, e.g. for "struct Obj { char a; double b; char c; REFLECT(Obj, a, b, c) };"
+//
+// RareTs::layout<Obj>::members[1].offset // 8, members are described by name, index, offset, size, alignment & trailing padding
+// RareTs::layout<Obj>::padding // 14, the bytes of Obj not occupied by members
+// RareTs::layout<Obj>::optimal_order // { 1, 0, 2 }, member indexes in the order which minimizes padding (by descending alignment)
+// RareTs::layout<Obj>::optimal_size // 16, sizeof(Obj) had members been declared in optimal_order
+// static_assert(RareTs::max_padding<Obj, 6>); // Fails to compile, catching padding regressions at build time
+//
+// Only instance data members are described, offsets come from offsetof so each must be REFLECT-ed by name (not a reference, and not
+// from an aggregate which was reflected without the REFLECT macro); bytes before the first member (e.g. supers or a vtable pointer) are
+// not considered padding
+namespace RareTs
+{
+    inline namespace MemoryLayout
+    {
+        struct member_layout
+        {
+            std::string_view name;
+            size_t index; // The index of the member in RareTs::Members<T>
+            size_t offset;
+            size_t size;
+            size_t alignment;
+            size_t padding; // The padding bytes between the end of this member and the next member (or the end of the object)
+        };
+
+        template <typename T>
+        class layout
+        {
+            template <size_t ... Is> static constexpr auto instanceData(std::index_sequence<Is...>)
+                -> typename RareTs::type_mask<RareTs::Filter::IsInstanceData, RareTs::Member<T, Is>...>::indexes;
+
+            using indexes = decltype(instanceData(std::make_index_sequence<RareTs::Members<T>::total>()));
+
+            template <size_t ... Is> static constexpr auto describeMembers(std::index_sequence<Is...>)
+            {
+                static_assert(((RareTs::Member<T, Is>::getOffset() != std::numeric_limits<size_t>::max()) && ...),
+                    "Layouts require the offset of every instance data member, references and unREFLECT-ed aggregates are unsupported");
+
+                return std::array<member_layout, sizeof...(Is)> {
+                    member_layout {
+                        RareTs::Member<T, Is>::name,
+                        Is,
+                        RareTs::Member<T, Is>::getOffset(),
+                        sizeof(typename RareTs::Member<T, Is>::type),
+                        alignof(typename RareTs::Member<T, Is>::type),
+                        0
+                    }...
+                };
+            }
+
+            static constexpr auto sortedMembers()
+            {
+                auto result = describeMembers(indexes{});
+                for ( size_t i=1; i<result.size(); ++i ) // Insertion sort by offset
+                {
+                    for ( size_t j=i; j>0 && result[j].offset < result[j-1].offset; --j )
+                    {
+                        member_layout temp = result[j];
+                        result[j] = result[j-1];
+                        result[j-1] = temp;
+                    }
+                }
+                for ( size_t i=0; i<result.size(); ++i )
+                {
+                    size_t end = result[i].offset + result[i].size;
+                    size_t next = i+1 < result.size() ? result[i+1].offset : sizeof(T);
+                    result[i].padding = next > end ? next - end : 0;
+                }
+                return result;
+            }
+
+            static constexpr auto sortedByAlignment()
+            {
+                auto result = sortedMembers();
+                for ( size_t i=1; i<result.size(); ++i ) // Stable insertion sort by descending alignment
+                {
+                    for ( size_t j=i; j>0 && result[j].alignment > result[j-1].alignment; --j )
+                    {
+                        member_layout temp = result[j];
+                        result[j] = result[j-1];
+                        result[j-1] = temp;
+                    }
+                }
+                return result;
+            }
+
+            static constexpr size_t alignUp(size_t offset, size_t alignment) { return (offset + alignment - 1) / alignment * alignment; }
+
+        public:
+            static constexpr size_t size = sizeof(T);
+            static constexpr size_t alignment = alignof(T);
+
+            // Descriptions of each instance data member, ordered by offset
+            static constexpr auto members = sortedMembers();
+
+            // The offset of the first member, bytes before this belong to supers or implementation details such as vtable pointers
+            static constexpr size_t members_offset = members.empty() ? sizeof(T) : members[0].offset;
+
+            static constexpr size_t member_bytes = [](){
+                size_t total = 0;
+                for ( const auto & member : members )
+                    total += member.size;
+                return total;
+            }();
+
+            static constexpr size_t padding = sizeof(T) - members_offset - member_bytes;
+
+            // Member indexes in the order which minimizes padding, members of equal alignment keep their current relative order
+            static constexpr auto optimal_order = [](){
+                auto sorted = sortedByAlignment();
+                std::array<size_t, members.size()> result {};
+                for ( size_t i=0; i<sorted.size(); ++i )
+                    result[i] = sorted[i].index;
+                return result;
+            }();
+
+            static constexpr size_t optimal_size = [](){
+                size_t offset = members_offset;
+                for ( const auto & member : sortedByAlignment() )
+                    offset = alignUp(offset, member.alignment) + member.size;
+                return alignUp(offset, alignof(T));
+            }();
+
+            static constexpr size_t optimal_padding = optimal_size - members_offset - member_bytes;
+        };
+
+        // True if T contains no more than N bytes of padding, e.g. static_assert(RareTs::max_padding<HotStruct, 0>);
+        template <typename T, size_t N>
+        inline constexpr bool max_padding = layout<T>::padding <= N;
+    }
+}
+
+#endif
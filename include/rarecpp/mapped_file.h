@@ -0,0 +1,185 @@
+// MIT License, Copyright (c) 2019-2025 Justin F https://github.com/TheNitesWhoSay/RareCpp/blob/master/LICENSE
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+#include "string_buffer.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#define MAPPEDFILE_UNDEF_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#define MAPPEDFILE_UNDEF_NOMINMAX
+#endif
+#include <windows.h>
+#ifdef MAPPEDFILE_UNDEF_LEAN_AND_MEAN
+#undef WIN32_LEAN_AND_MEAN
+#undef MAPPEDFILE_UNDEF_LEAN_AND_MEAN
+#endif
+#ifdef MAPPEDFILE_UNDEF_NOMINMAX
+#undef NOMINMAX
+#undef MAPPEDFILE_UNDEF_NOMINMAX
+#endif
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace RareBufferedStream
+{
+    // A read-only memory mapping of an entire file, the mapping is released on destruction; use isOpen() to check whether the file
+    // was successfully mapped (an empty file opens successfully with an empty view)
+    class MappedFile
+    {
+        public:
+            MappedFile() = default;
+            MappedFile(const std::string & path) { open(path); }
+            MappedFile(const MappedFile &) = delete;
+            MappedFile(MappedFile && other) noexcept { swap(other); }
+
+            MappedFile & operator=(const MappedFile &) = delete;
+            MappedFile & operator=(MappedFile && other) noexcept
+            {
+                close();
+                swap(other);
+                return *this;
+            }
+
+            ~MappedFile() { close(); }
+
+            inline bool open(const std::string & path)
+            {
+                close();
+#ifdef _WIN32
+                file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if ( file == INVALID_HANDLE_VALUE )
+                    return false;
+
+                LARGE_INTEGER fileSize {};
+                if ( !::GetFileSizeEx(file, &fileSize) )
+                {
+                    close();
+                    return false;
+                }
+
+                opened = true;
+                size = size_t(fileSize.QuadPart);
+                if ( size > 0 )
+                {
+                    mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    if ( mapping != nullptr )
+                        data = static_cast<const char*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+                    if ( data == nullptr )
+                        close();
+                }
+#else
+                int fd = ::open(path.c_str(), O_RDONLY);
+                if ( fd < 0 )
+                    return false;
+
+                struct stat fileStat {};
+                if ( ::fstat(fd, &fileStat) == 0 )
+                {
+                    opened = true;
+                    size = size_t(fileStat.st_size);
+                    if ( size > 0 )
+                    {
+                        void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                        if ( mapped == MAP_FAILED )
+                            close();
+                        else
+                        {
+                            data = static_cast<const char*>(mapped);
+                            ::madvise(mapped, size, MADV_SEQUENTIAL);
+                        }
+                    }
+                }
+                ::close(fd); // The mapping remains valid after the descriptor is closed
+#endif
+                return opened;
+            }
+
+            inline void close()
+            {
+#ifdef _WIN32
+                if ( data != nullptr )
+                    ::UnmapViewOfFile(data);
+                if ( mapping != nullptr )
+                    ::CloseHandle(mapping);
+                if ( file != INVALID_HANDLE_VALUE )
+                    ::CloseHandle(file);
+
+                mapping = nullptr;
+                file = INVALID_HANDLE_VALUE;
+#else
+                if ( data != nullptr )
+                    ::munmap(const_cast<char*>(data), size);
+#endif
+                data = nullptr;
+                size = 0;
+                opened = false;
+            }
+
+            inline bool isOpen() const noexcept
+            {
+                return opened;
+            }
+
+            inline std::string_view view() const noexcept
+            {
+                return data == nullptr ? std::string_view() : std::string_view(data, size);
+            }
+
+            inline void swap(MappedFile & other) noexcept
+            {
+#ifdef _WIN32
+                std::swap(file, other.file);
+                std::swap(mapping, other.mapping);
+#endif
+                std::swap(data, other.data);
+                std::swap(size, other.size);
+                std::swap(opened, other.opened);
+            }
+
+        private:
+#ifdef _WIN32
+            HANDLE file = INVALID_HANDLE_VALUE;
+            HANDLE mapping = nullptr;
+#endif
+            const char* data = nullptr;
+            size_t size = 0;
+            bool opened = false;
+    };
+
+    // An istream reading directly from a memory-mapped file, e.g. "MappedStringBuffer is(path); is >> Json::in(obj);"
+    // Unlike reading a std::ifstream into a StringBuffer nothing is copied out of the page cache
+    class MappedStringBuffer : public ViewStringBuffer
+    {
+        public:
+            MappedStringBuffer(const std::string & path) : ViewStringBuffer(), file(path)
+            {
+                reset(file.view());
+                if ( !file.isOpen() )
+                    ((std::istream*)this)->setstate(std::ios_base::failbit);
+            }
+
+            virtual ~MappedStringBuffer() {}
+
+            inline bool isOpen() const noexcept
+            {
+                return file.isOpen();
+            }
+
+        private:
+            MappedFile file;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,150 @@
+// MIT License, Copyright (c) 2019-2025 Justin F https://github.com/TheNitesWhoSay/RareCpp/blob/master/LICENSE
+#ifndef PARALLELMAP_H
+#define PARALLELMAP_H
+#ifndef REFLECT_H
+#include "reflect.h"
+#endif
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Opt-in parallel mapping of large random-access containers, e.g. "RareMapper::map(RareMapper::parallel, domainRecords, wireRecords);"
+//
+// The destination is resized to the size of the source then split into one contiguous chunk per thread, each chunk's elements are mapped
+// concurrently using RareMapper::map (so element mappings must not share mutable state); RareMapper::mapMove(RareMapper::parallel, ...)
+// moves the elements of rvalue sources
+// Containers smaller than the threshold, containers which aren't random-access & resizable, and mappings which are a single memcpy (which is
+// bound by memory bandwidth rather than by the work per element) are mapped sequentially using RareMapper::map or RareMapper::mapMove
+namespace RareMapper
+{
+    struct Parallel
+    {
+        size_t threads = 0; // The most threads to map with, including the calling thread; 0 uses std::thread::hardware_concurrency()
+        size_t threshold = 4096; // Containers with fewer elements than this are mapped sequentially
+    };
+
+    inline constexpr Parallel parallel {};
+
+    namespace detail
+    {
+        template <typename T, typename = void> struct is_random_access { static constexpr bool value = false; };
+        template <typename T> struct is_random_access<T, std::enable_if_t<std::is_base_of_v<std::random_access_iterator_tag,
+            typename std::iterator_traits<decltype(std::begin(std::declval<T &>()))>::iterator_category>>> { static constexpr bool value = true; };
+
+        template <typename To, typename From> inline constexpr bool isParallelMappable = !std::is_const_v<To> &&
+            is_random_access<To>::value && is_random_access<From>::value && hasResize<To> && hasSize<From> &&
+            std::is_same_v<decltype(*std::begin(std::declval<To &>())), RareTs::element_type_t<To> &> && // Excludes proxies like vector<bool>
+            std::is_move_assignable_v<RareTs::element_type_t<To>> &&
+            !(isContiguous<To> && isContiguous<From> &&
+                isLayoutIdentical<RareTs::element_type_t<To>, RareTs::remove_cvref_t<decltype(*std::begin(std::declval<From &>()))>>());
+
+        template <bool Move, typename To, typename From> inline void mapSequential(To & to, From & from)
+        {
+            if constexpr ( Move )
+                RareMapper::mapMove(to, std::move(from));
+            else
+                RareMapper::map(to, std::as_const(from));
+        }
+
+        template <bool Move, typename To, typename From> inline void mapParallel(const Parallel & policy, To & to, From & from)
+        {
+            if constexpr ( isParallelMappable<To, From> )
+            {
+                size_t size = size_t(std::size(from));
+                size_t threads = policy.threads > 0 ? policy.threads : std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+                if ( size < policy.threshold || threads < 2 || size < 2 )
+                    return mapSequential<Move>(to, from);
+
+                using ToElementType = RareTs::element_type_t<To>;
+                using FromElementType = RareTs::remove_cvref_t<decltype(*std::begin(from))>;
+                constexpr bool resetsUnmapped = isMappedByMemberName<ToElementType, FromElementType>;
+                std::conditional_t<resetsUnmapped, ToElementType, std::nullptr_t> defaults {}; // Read by every chunk, never written
+                size_t reused = std::min(size_t(std::size(to)), size);
+
+                size_t chunkSize = (size + threads - 1) / threads;
+                threads = (size + chunkSize - 1) / chunkSize; // Every chunk starts within the container
+                to.resize(size);
+
+                std::vector<std::exception_ptr> exceptions(threads);
+                auto mapChunk = [&](size_t chunk) {
+                    try {
+                        auto toElement = std::next(std::begin(to), std::ptrdiff_t(chunk*chunkSize));
+                        auto fromElement = std::next(std::begin(from), std::ptrdiff_t(chunk*chunkSize));
+                        for ( size_t i=chunk*chunkSize, end=std::min(size, (chunk+1)*chunkSize); i<end; ++i, ++toElement, ++fromElement )
+                        {
+                            if constexpr ( resetsUnmapped )
+                            {
+                                if ( i < reused )
+                                    resetUnmapped<FromElementType>(*toElement, defaults);
+                            }
+                            mapForwarded(*toElement, forwardElement<Move>(*fromElement));
+                        }
+                    } catch ( ... ) {
+                        exceptions[chunk] = std::current_exception();
+                    }
+                };
+
+                std::vector<std::thread> workers {};
+                auto joinWorkers = [&]() {
+                    for ( auto & worker : workers )
+                        worker.join();
+                };
+                try {
+                    workers.reserve(threads-1);
+                    for ( size_t chunk=1; chunk<threads; ++chunk )
+                        workers.emplace_back(mapChunk, chunk);
+                } catch ( ... ) {
+                    joinWorkers(); // Started workers must be joined before their destruction
+                    throw;
+                }
+
+                mapChunk(0);
+                joinWorkers();
+
+                for ( auto & exception : exceptions )
+                {
+                    if ( exception != nullptr )
+                        std::rethrow_exception(exception);
+                }
+            }
+            else
+                mapSequential<Move>(to, from);
+        }
+    }
+
+    // Maps "from" to "to" as with RareMapper::map(to, from), mapping the elements of large random-access containers on several threads
+    template <typename To, typename From> inline void map(const Parallel & policy, To & to, const From & from)
+    {
+        detail::mapParallel<false>(policy, to, from);
+    }
+
+    // Maps "from" to "to" as with RareMapper::mapMove(to, std::move(from)), moving the elements of large random-access containers on
+    // several threads
+    template <typename To, typename From, enable_if_rvalue_t<From> = 0> inline void mapMove(const Parallel & policy, To & to, From && from)
+    {
+        detail::mapParallel<true>(policy, to, from);
+    }
+
+    // Helper method for RareMapper::map(const Parallel &, To &, const From &); do not specialize this method
+    template <typename To, typename From> inline To map(const Parallel & policy, const From & from)
+    {
+        To to;
+        RareMapper::map(policy, to, from);
+        return to;
+    }
+
+    // Helper method for RareMapper::mapMove(const Parallel &, To &, From &&); do not specialize this method
+    template <typename To, typename From, enable_if_rvalue_t<From> = 0> inline To mapMove(const Parallel & policy, From && from)
+    {
+        To to;
+        RareMapper::mapMove(policy, to, std::move(from));
+        return to;
+    }
+}
+
+#endif
@@ -3,6 +3,8 @@
 #define REFLECT_H
 #include <array>
 #include <cstddef>
+#include <cstring>
+#include <iterator>
 #include <limits>
 #include <stdexcept>
 #include <string_view>
@@ -364,6 +366,9 @@ i0,i1,i2,i3,i4,i5,i6,i7,i8,i9,j0,j1,j2,j3,j4,j5,j6,j7,j8,argAtArgMax,...) argAtA
             template <typename L, typename R> using AssignmentOp = decltype(std::declval<L>() = std::declval<const R &>());
             template <typename L, typename R> using StaticCastAssignmentOp = decltype(
                 std::declval<L>() = static_cast<std::remove_reference_t<L>>(std::declval<const R &>()));
+            template <typename L, typename R> using MoveAssignmentOp = decltype(std::declval<L>() = std::declval<R &&>());
+            template <typename L, typename R> using StaticCastMoveAssignmentOp = decltype(
+                std::declval<L>() = static_cast<std::remove_reference_t<L>>(std::declval<R &&>()));
             template <typename T> using BeginOp = decltype(std::declval<T>().begin());
             template <typename T> using EndOp = decltype(std::declval<T>().end());
             template <typename T> using PopBackOp = decltype(std::declval<T>().pop_back());
@@ -385,6 +390,13 @@ i0,i1,i2,i3,i4,i5,i6,i7,i8,i9,j0,j1,j2,j3,j4,j5,j6,j7,j8,argAtArgMax,...) argAtA
 
         template <typename L, typename R> struct is_static_cast_assignable : op_exists<void, detail::StaticCastAssignmentOp, L, R> {};
         template <typename L, typename R> inline constexpr bool is_static_cast_assignable_v = is_static_cast_assignable<L, R>::value;
+
+        // As with is_assignable & is_static_cast_assignable, but for assignment from an rvalue R (e.g. std::move(r))
+        template <typename L, typename R> struct is_move_assignable : op_exists<void, detail::MoveAssignmentOp, L, R> {};
+        template <typename L, typename R> inline constexpr bool is_move_assignable_v = is_move_assignable<L, R>::value;
+
+        template <typename L, typename R> struct is_static_cast_move_assignable : op_exists<void, detail::StaticCastMoveAssignmentOp, L, R> {};
+        template <typename L, typename R> inline constexpr bool is_static_cast_move_assignable_v = is_static_cast_move_assignable<L, R>::value;
         
         template <typename T> struct has_begin_end { static constexpr bool value = op_exists_v<detail::BeginOp, T> && op_exists_v<detail::EndOp, T>; };
         template <typename T> inline constexpr bool has_begin_end_v = has_begin_end<T>::value;
@@ -3457,7 +3469,35 @@ template <typename T> struct RareBuilder : decltype(RareTs::AdaptiveStructures::
 
 namespace RareMapper
 {
+    template <typename From> using enable_if_rvalue_t = std::enable_if_t<!std::is_reference_v<From> && !std::is_const_v<From>, int>;
+
     template <typename To, typename From> constexpr void map(To & to, const From & from);
+    template <typename To, typename From, enable_if_rvalue_t<From> = 0> constexpr void mapMove(To & to, From && from);
+
+    // Specializations of RareMapper::map(To &, const From &) can't be detected, specialize this alongside one so that it's also used by
+    // RareMapper::mapMove (which would otherwise move "from" memberwise) and where elements would otherwise be byte-copied, e.g.
+    // "template <> struct RareMapper::IsSpecialized<To, From> : std::true_type {};"
+    template <typename To, typename From> struct IsSpecialized : std::false_type {};
+    template <typename To, typename From> inline constexpr bool is_specialized_v =
+        IsSpecialized<std::remove_cv_t<To>, RareTs::remove_cvref_t<From>>::value;
+
+    // Containers of distinct REFLECT-ed types with identically named, typed & positioned members are only copied with memcpy (rather than
+    // mapped element by element, which would use any specialization) for type pairs which opt in, e.g.
+    // "template <> struct RareMapper::IsLayoutMapped<Domain, Wire> : std::true_type {};"
+    template <typename To, typename From> struct IsLayoutMapped : std::false_type {};
+
+    namespace detail
+    {
+        // Maps using RareMapper::mapMove if "from" is a non-const rvalue, else using RareMapper::map (e.g. for elements of sets, map keys
+        // and members which are mapped more than once)
+        template <typename To, typename From> constexpr void mapForwarded(To & to, From && from)
+        {
+            if constexpr ( !std::is_reference_v<From> && !std::is_const_v<From> )
+                RareMapper::mapMove(to, std::move(from));
+            else
+                RareMapper::map(to, std::as_const(from));
+        }
+    }
 
     namespace detail
     {
@@ -3571,8 +3611,30 @@ namespace RareMapper
                     (RareMapper::map(RareTs::Member<To, Ts::Left>::value(to), RareTs::Member<From, Ts::Right>::value(from)), ...);
                 }
             }
+
+            template <size_t FromIndex, typename FromValue> static constexpr decltype(auto) moveIfUnique(FromValue & fromValue)
+            {
+                constexpr size_t uses = mapping<To, From, AllMappings<To, From>>::template is_forward<To, From> ?
+                    (size_t(0) + ... + (Ts::Left == FromIndex ? 1 : 0)) : (size_t(0) + ... + (Ts::Right == FromIndex ? 1 : 0));
+                if constexpr ( uses == 1 && !RareTs::Member<From, FromIndex>::isStatic )
+                    return std::move(fromValue);
+                else // A from-member mapped to several to-members (or a static) is copied
+                    return std::as_const(fromValue);
+            }
+
+            static constexpr void map(To & to, From && from)
+            {
+                if constexpr ( mapping<To, From, AllMappings<To, From>>::template is_forward<To, From> ) {
+                    (mapForwarded(RareTs::Member<To, Ts::Right>::value(to), moveIfUnique<Ts::Left>(RareTs::Member<From, Ts::Left>::value(from))), ...);
+                } else {
+                    (mapForwarded(RareTs::Member<To, Ts::Left>::value(to), moveIfUnique<Ts::Right>(RareTs::Member<From, Ts::Right>::value(from))), ...);
+                }
+            }
+        };
+        template <typename To, typename From> struct NoteMapper<To, From, void> {
+            static constexpr void map(To &, const From &) {}
+            static constexpr void map(To &, From &&) {}
         };
-        template <typename To, typename From> struct NoteMapper<To, From, void> { static constexpr void map(To &, const From &) {} };
         template <typename To, typename From, typename ... Ts> struct NoteMapper<To, From, std::tuple<Ts...>> : NoteMapper<To, From, Ts...> {};
         template <typename To, typename From> struct NoteMapper<To, From>
             : NoteMapper<To, From, mapping_t<To, From>> {};
@@ -3599,6 +3661,159 @@ namespace RareMapper
                 RareMapper::detail::mapTuple<Index+1>(to, from);
             }
         }
+
+        // Helper method for RareMapper::mapMoveDefault(To &, From &&); do not specialize this method
+        template <size_t Index, typename ...To, typename ...From> MSVC_UNUSED_FALSE_POSITIVE
+        constexpr void mapTuple(std::tuple<To...> & to, std::tuple<From...> && from)
+        {
+            if constexpr ( Index < sizeof...(To) && Index < sizeof...(From) )
+            {
+                mapForwarded(std::get<Index>(to), std::get<Index>(std::move(from)));
+                RareMapper::detail::mapTuple<Index+1>(to, std::move(from));
+            }
+        }
+
+        template <typename T> using ReserveOp = decltype(std::declval<T &>().reserve(size_t(0)));
+        template <typename T> using ResizeOp = decltype(std::declval<T &>().resize(size_t(0)));
+        template <typename T> using SizeOp = decltype(std::size(std::declval<const T &>()));
+        template <typename T> using DataOp = std::enable_if_t<std::is_pointer_v<decltype(std::data(std::declval<T &>()))>>;
+
+        template <typename T> inline constexpr bool hasReserve = RareTs::op_exists_v<ReserveOp, T>;
+        template <typename T> inline constexpr bool hasResize = RareTs::op_exists_v<ResizeOp, T>;
+        template <typename T> inline constexpr bool hasSize = RareTs::op_exists_v<SizeOp, T>;
+        template <typename T> inline constexpr bool isContiguous = RareTs::op_exists_v<DataOp, T>;
+
+        template <typename To, typename From, size_t ... Is> constexpr bool membersLayoutIdentical(std::index_sequence<Is...>)
+        {
+            return ((std::string_view(RareTs::Class::member_name<To, Is>) == std::string_view(RareTs::Class::member_name<From, Is>) &&
+                std::is_same_v<RareTs::Class::member_type<To, Is>, RareTs::Class::member_type<From, Is>> &&
+                RareTs::Class::is_static<To, Is> == RareTs::Class::is_static<From, Is> &&
+                RareTs::Class::member_offset<To, Is> == RareTs::Class::member_offset<From, Is>) && ...);
+        }
+
+        // True if mapping a From to a To is equivalent to copying its bytes: the types are the same, or are opted in with IsLayoutMapped
+        // and REFLECT-ed with identically named, typed & positioned members (and nothing else customizing the mapping); in either case
+        // being trivially copyable
+        template <typename To, typename From> constexpr bool isLayoutIdentical()
+        {
+            if constexpr ( !std::is_trivially_copyable_v<To> || !std::is_trivially_copyable_v<From> || sizeof(To) != sizeof(From) ||
+                std::is_const_v<To> || is_specialized_v<To, From> )
+                return false;
+            else if constexpr ( std::is_same_v<To, std::remove_const_t<From>> )
+                return true;
+            else if constexpr ( IsLayoutMapped<To, std::remove_const_t<From>>::value && RareTs::is_macro_reflected_v<To> &&
+                RareTs::is_macro_reflected_v<From> && !hasObjectMemberMapping<To, From> && !hasMapFrom<To, From> && !hasMapTo<From, To> )
+            {
+                if constexpr ( RareTs::Class::member_count<To> == RareTs::Class::member_count<From> &&
+                    RareTs::Supers<To>::total == 0 && RareTs::Supers<From>::total == 0 )
+                {
+                    return membersLayoutIdentical<To, From>(std::make_index_sequence<RareTs::Class::member_count<To>>());
+                }
+                else
+                    return false;
+            }
+            else
+                return false;
+        }
+
+        // Whether mapDefault has a memberwise/elementwise mapping, aggregates which lack REFLECT are more often mapped by specialization
+        template <typename To, typename From> inline constexpr bool isMoveMappable =
+            RareTs::is_pointable_v<To> || RareTs::is_pointable_v<From> || (RareTs::is_pair_v<To> && RareTs::is_pair_v<From>) ||
+            (RareTs::is_tuple_v<To> && RareTs::is_tuple_v<From>) || (RareTs::is_iterable_v<To> && RareTs::is_iterable_v<From>) ||
+            (RareTs::is_macro_reflected_v<To> && RareTs::is_macro_reflected_v<From>);
+
+        template <bool Move, typename T> constexpr decltype(auto) forwardElement(T & element)
+        {
+            if constexpr ( Move )
+                return std::move(element);
+            else
+                return std::as_const(element);
+        }
+
+        template <typename T> constexpr bool hasMemberNamed(std::string_view name)
+        {
+            bool found = false;
+            RareTs::Reflect<T>::Members::forEach([&](auto & member) {
+                if ( std::string_view(member.name) == name )
+                    found = true;
+            });
+            return found;
+        }
+
+        // Whether mapping a From to a To falls to mapDefault's same-named members mapping, which leaves members of To lacking a same-named
+        // member in From unassigned
+        template <typename To, typename From> inline constexpr bool isMappedByMemberName = RareTs::is_reflected_v<To> &&
+            RareTs::is_reflected_v<From> && !is_specialized_v<To, From> && !hasMapFrom<To, From> && !hasMapTo<From, To> &&
+            !hasObjectMemberMapping<To, From> && !RareTs::is_assignable_v<To &, From> && !RareTs::is_static_cast_assignable_v<To &, From> &&
+            !RareTs::is_pointable_v<To> && !RareTs::is_pointable_v<From> && !RareTs::is_iterable_v<To> && !RareTs::is_iterable_v<From> &&
+            !RareTs::is_pair_v<To> && !RareTs::is_tuple_v<To>;
+
+        // Resets the members of an element reused from a resized container which mapping from a From won't assign to their values in a new
+        // element (defaults), members which will be assigned are left alone so that their storage (e.g. string & vector capacity) is reused
+        template <typename From, typename To> constexpr void resetUnmapped(To & element, const To & defaults)
+        {
+            if constexpr ( isMappedByMemberName<To, From> )
+            {
+                RareTs::Reflect<To>::Members::template forEach<RareTs::Filter::IsInstanceData>(element, [&](auto & member, auto & value) {
+                    using Member = RareTs::remove_cvref_t<decltype(member)>;
+                    using Value = std::remove_reference_t<decltype(value)>;
+                    if constexpr ( !std::is_const_v<Value> && std::is_copy_assignable_v<Value> && !hasMemberNamed<From>(Member::name) )
+                        value = Member::value(defaults);
+                });
+            }
+        }
+
+        // Helper method for RareMapper::mapDefault mapping between begin/end iterables or adaptors; do not specialize this method
+        // Layout-identical elements of contiguous containers are copied in a single memcpy, sequence containers which can be resized and
+        // whose elements are move-assignable have their existing elements reused (elements are mapped in place, members the mapping won't
+        // assign are reset), other containers are cleared, reserved & appended to
+        template <bool Move, typename To, typename From> constexpr void mapIterable(To & to, From & from)
+        {
+            using ToElementType = RareTs::element_type_t<std::remove_cv_t<To>>;
+            if constexpr ( hasResize<To> && hasSize<From> && isContiguous<To> && isContiguous<From> &&
+                isLayoutIdentical<ToElementType, RareTs::remove_cvref_t<decltype(*std::data(from))>>() )
+            {
+                to.resize(std::size(from));
+                if ( std::size(from) > 0 )
+                    std::memcpy(static_cast<void*>(std::data(to)), std::data(from), std::size(from)*sizeof(ToElementType));
+            }
+            else if constexpr ( hasResize<To> && hasSize<From> && std::is_same_v<decltype(*std::begin(to)), ToElementType &> &&
+                std::is_move_assignable_v<ToElementType> )
+            {
+                using FromElementType = RareTs::remove_cvref_t<decltype(*std::begin(from))>;
+                size_t reused = std::size(to) < std::size(from) ? size_t(std::size(to)) : size_t(std::size(from));
+                to.resize(std::size(from));
+                if constexpr ( isMappedByMemberName<ToElementType, FromElementType> )
+                {
+                    if ( reused > 0 )
+                    {
+                        const ToElementType defaults {};
+                        auto reusedElement = std::begin(to);
+                        for ( size_t i=0; i<reused; ++i, ++reusedElement )
+                            resetUnmapped<FromElementType>(*reusedElement, defaults);
+                    }
+                }
+                auto toElement = std::begin(to);
+                for ( auto & fromElement : from )
+                {
+                    mapForwarded(*toElement, forwardElement<Move>(fromElement));
+                    ++toElement;
+                }
+            }
+            else
+            {
+                RareTs::clear(to);
+                if constexpr ( hasReserve<To> && hasSize<From> )
+                    to.reserve(std::size(from));
+
+                for ( auto & fromElement : from )
+                {
+                    ToElementType toElement;
+                    mapForwarded(toElement, forwardElement<Move>(fromElement));
+                    RareTs::append(to, std::move(toElement));
+                }
+            }
+        }
     }
     
     template <typename L, typename R> constexpr auto createMapping() {
@@ -3609,6 +3824,10 @@ namespace RareMapper
     // Default mapping implementation, safe to call from RareMapper::map specializations, assignment & conversion operators, and map_to/map_from methods
     // Do not specialize this method
     template <typename To, typename From> constexpr void mapDefault(To &, const From &);
+
+    // Default mapping implementation for RareMapper::mapMove, members and elements are moved out of "from" rather than copied
+    // Do not specialize this method
+    template <typename To, typename From, enable_if_rvalue_t<From> = 0> constexpr void mapMoveDefault(To &, From &&);
     
     // Default mapping helper, safe to call from RareMapper::map specializations, assignment & conversion operators, and map_to/map_from methods
     // Do not specialize this method
@@ -3619,6 +3838,14 @@ namespace RareMapper
         return to;
     }
 
+    // Default mapping helper for RareMapper::mapMove; do not specialize this method
+    template<typename To, typename From, enable_if_rvalue_t<From> = 0> constexpr To mapMoveDefault(From && from)
+    {
+        To to;
+        RareMapper::mapMoveDefault(to, std::move(from));
+        return to;
+    }
+
     // If any mapping exists from "from" to "to", "to" is assigned mapped values from "from", if no mapping exists, "to" is unchanged and nothing is thrown
     // A mapping may exist if...
     // - Both "To" and "From" are reflected objects and have members with identical names and compatible types
@@ -3649,6 +3876,33 @@ namespace RareMapper
             RareMapper::mapDefault(to, from);
     }
 
+    // Maps from an rvalue "from" (e.g. a temporary or std::move(dto)) as RareMapper::map does, but stealing rather than copying where the
+    // mapping is by...
+    // - Assignment or static_cast assignment (the moved "from" is used)
+    // - ObjectMappings notes, or identically named members of REFLECT-ed objects (members are moved)
+    // - Compatible pairs, tuples, arrays, STL containers or unique pointers (elements are moved)
+    // Pointees of shared & raw pointers may be referenced elsewhere and are copied, map_to & map_from methods are given a const "from"
+    // Moving is opt-in: RareMapper::map copies rvalues as it does lvalues, running any specializations. Specializations of
+    // RareMapper::map(To &, const From &) marked with RareMapper::IsSpecialized are used by mapMove ahead of the above (the source is then
+    // copied), unmarked specializations are only reached when none of the above apply
+    template <typename To, typename From, enable_if_rvalue_t<From>> constexpr void mapMove(To & to, From && from)
+    {
+        if constexpr ( std::is_const_v<To> )
+            return;
+        else if constexpr ( is_specialized_v<To, From> || detail::hasMapFrom<To, From> || detail::hasMapTo<From, To> )
+            RareMapper::map(to, std::as_const(from));
+        else if constexpr ( detail::hasObjectMemberMapping<To, From> )
+            detail::NoteMapper<To, From>::map(to, std::move(from));
+        else if constexpr ( RareTs::is_move_assignable_v<To &, From> )
+            to = std::move(from);
+        else if constexpr ( RareTs::is_static_cast_move_assignable_v<To &, From> )
+            to = static_cast<To>(std::move(from));
+        else if constexpr ( detail::isMoveMappable<To, From> )
+            RareMapper::mapMoveDefault(to, std::move(from));
+        else
+            RareMapper::map(to, std::as_const(from));
+    }
+
     // Helper method for RareMapper::map(To &, From &); do not specialize this method
     template <typename To, typename From> constexpr To map(const From & from)
     {
@@ -3657,6 +3911,14 @@ namespace RareMapper
         return to;
     }
 
+    // Helper method for RareMapper::mapMove(To &, From &&); do not specialize this method
+    template <typename To, typename From, enable_if_rvalue_t<From> = 0> constexpr To mapMove(From && from)
+    {
+        To to;
+        RareMapper::mapMove(to, std::move(from));
+        return to;
+    }
+
     template <typename To, typename From> constexpr void mapDefault(To & to, const From & from)
     {
         if constexpr ( std::is_const_v<To> )
@@ -3728,15 +3990,7 @@ namespace RareMapper
         {
             using ToElementType = RareTs::element_type_t<std::remove_cv_t<To>>;
             if constexpr ( (RareTs::has_begin_end_v<To> || RareTs::is_adaptor_v<To>) && (RareTs::has_begin_end_v<From> || RareTs::is_adaptor_v<From>) )
-            {
-                RareTs::clear(to);
-                for ( auto & fromElement : from )
-                {
-                    ToElementType toElement;
-                    RareMapper::map(toElement, fromElement);
-                    RareTs::append(to, toElement);
-                }
-            }
+                RareMapper::detail::mapIterable<false>(to, from);
             else if constexpr ( RareTs::is_static_array_v<From> && RareTs::static_array_size<From>::value > 0 )
             {
                 if constexpr ( RareTs::is_static_array_v<To> && RareTs::static_array_size<To>::value > 0 )
@@ -3754,7 +4008,7 @@ namespace RareMapper
                     {
                         ToElementType toElement;
                         RareMapper::map(toElement, from[i]);
-                        RareTs::append(to, toElement);
+                        RareTs::append(to, std::move(toElement));
                     }
                 }
             }
@@ -3780,6 +4034,102 @@ namespace RareMapper
         }
     }
 
+    template <typename To, typename From, enable_if_rvalue_t<From>> constexpr void mapMoveDefault(To & to, From && from)
+    {
+        if constexpr ( std::is_const_v<To> )
+            return;
+        else if constexpr ( RareTs::is_pointable_v<From> && !detail::is_unique_pointable_v<From> )
+            RareMapper::mapDefault(to, std::as_const(from)); // Pointees of shared & raw pointers may be referenced elsewhere, copy them
+        else if constexpr ( RareTs::is_pointable_v<To> )
+        {
+            using ToDereferenced = RareTs::remove_pointer_t<To>;
+            if constexpr ( RareTs::is_pointable_v<From> )
+            {
+                if ( from == nullptr )
+                    to = nullptr;
+                else if ( to != nullptr )
+                    detail::mapForwarded(*to, std::move(*from));
+                else if constexpr ( detail::is_shared_pointable_v<To> || detail::is_unique_pointable_v<To> )
+                {
+                    to = RareTs::remove_cvref_t<To>(new ToDereferenced); // Equivalent of std::make_shared/make_unique given a default-initialized ToDereferenced
+                    detail::mapForwarded(*to, std::move(*from));
+                }
+            }
+            else if ( to != nullptr )
+                detail::mapForwarded(*to, std::move(from));
+            else if constexpr ( detail::is_shared_pointable_v<To> || detail::is_unique_pointable_v<To> )
+            {
+                to = RareTs::remove_cvref_t<To>(new ToDereferenced); // Equivalent of std::make_shared/make_unique given a default-initialized ToDereferenced
+                detail::mapForwarded(*to, std::move(from));
+            }
+        }
+        else if constexpr ( RareTs::is_pointable_v<From> )
+        {
+            if ( from != nullptr )
+                detail::mapForwarded(to, std::move(*from));
+        }
+        else if constexpr ( RareTs::is_pair_v<To> && RareTs::is_pair_v<From> )
+        {
+            detail::mapForwarded(to.first, std::move(from.first));
+            detail::mapForwarded(to.second, std::move(from.second));
+        }
+        else if constexpr ( RareTs::is_tuple_v<To> && RareTs::is_tuple_v<From> )
+        {
+            RareMapper::detail::mapTuple<0>(to, std::move(from));
+        }
+        else if constexpr ( RareTs::is_iterable_v<To> && RareTs::is_iterable_v<From> )
+        {
+            using ToElementType = RareTs::element_type_t<std::remove_cv_t<To>>;
+            if constexpr ( (RareTs::has_begin_end_v<To> || RareTs::is_adaptor_v<To>) && (RareTs::has_begin_end_v<From> || RareTs::is_adaptor_v<From>) )
+                RareMapper::detail::mapIterable<true>(to, from); // Elements of sets & map keys are const and are copied
+            else if constexpr ( RareTs::is_static_array_v<From> && RareTs::static_array_size<From>::value > 0 )
+            {
+                if constexpr ( RareTs::is_static_array_v<To> && RareTs::static_array_size<To>::value > 0 )
+                {
+                    constexpr size_t toSize = RareTs::static_array_size_v<To>;
+                    constexpr size_t fromSize = RareTs::static_array_size_v<From>;
+                    constexpr size_t limit = toSize < fromSize ? toSize : fromSize;
+                    for ( size_t i=0; i<limit; i++ )
+                        detail::mapForwarded(to[i], std::move(from[i]));
+                }
+                else
+                {
+                    RareTs::clear(to);
+                    for ( size_t i=0; i<RareTs::static_array_size_v<From>; i++ )
+                    {
+                        ToElementType toElement;
+                        detail::mapForwarded(toElement, std::move(from[i]));
+                        RareTs::append(to, std::move(toElement));
+                    }
+                }
+            }
+            else if constexpr ( RareTs::is_static_array_v<To> && RareTs::static_array_size<To>::value > 0 )
+            {
+                size_t i=0;
+                for ( auto & element : from )
+                {
+                    detail::mapForwarded(to[i], std::move(element));
+                    if ( ++i == RareTs::static_array_size_v<To> )
+                        break;
+                }
+            }
+        }
+        else if constexpr ( RareTs::is_reflected_v<To> && RareTs::is_reflected_v<From> )
+        {
+            RareTs::Reflect<To>::Members::forEach(to, [&](auto toMember, auto & toValue) {
+                RareTs::Reflect<From>::Members::forEach(from, [&](auto fromMember, auto & fromValue) {
+                    if constexpr ( std::string_view(toMember.name) == std::string_view(fromMember.name) )
+                    {
+                        if constexpr ( decltype(fromMember)::isStatic || std::is_reference_v<typename decltype(fromMember)::type> )
+                            RareMapper::map(toValue, std::as_const(fromValue)); // Statics & referenced values are not owned by from, copy them
+                        else
+                            detail::mapForwarded(toValue, std::move(fromValue));
+                    }
+                });
+            });
+        }
+    }
+
     template <typename MappedBy, typename Type = void> struct MappedByType { using Object = Type; using DefaultMapping = MappedBy; };
     template <typename MappedBy> struct MappedByType<MappedBy, void> { using DefaultMapping = MappedBy; };
 
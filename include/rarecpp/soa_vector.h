@@ -0,0 +1,253 @@
+// MIT License, Copyright (c) 2019-2025 Justin F https://github.com/TheNitesWhoSay/RareCpp/blob/master/LICENSE
+#ifndef SOAVECTOR_H
+#define SOAVECTOR_H
+#ifndef REFLECT_H
+#include "reflect.h"
+#endif
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#ifndef RARE_NO_CPP_20
+#include <span>
+#endif
+
+// A structure-of-arrays container generated from a REFLECT-ed type: each instance data member of T is stored in its own contiguous
+// column, e.g. for "struct Entity { float x; float y; std::string name; REFLECT(Entity, x, y, name) };"
+//
+// RareTs::soa_vector<Entity> entities;
+// entities.push_back(Entity{1.f, 2.f, "a"});
+// entities[0].x += 1.f; // Element access goes through a proxy with reference members named after the members of T
+// Entity copy = entities[0]; // Proxies convert to and can be assigned from T
+// for ( float & x : entities.column<RareTs::IndexOf<Entity>::x>() ) // Columns are available as spans (C++20) for tight loops...
+//     x *= 2.f;
+// RareTs::Members<Entity>::forEach<RareTs::Filter::IsInstanceData>([&](auto member) {
+//     auto column = entities.column(member); // ...or by member when iterating members
+// });
+//
+// Since std::vector<bool> does not store addressable bools, bool members are stored as RareTs::soa_bool (a wrapper around a bool)
+namespace RareTs
+{
+    inline namespace AdaptiveStructures
+    {
+        struct soa_bool { bool value; };
+
+        namespace detail
+        {
+            template <typename U> using soa_element_t = std::conditional_t<std::is_same_v<bool, U>, soa_bool, U>;
+
+            template <typename T, size_t I = std::numeric_limits<size_t>::max()>
+            struct soa_column : RareTs::Class::adapt_member<soa_column<T>::template type, T, I> {};
+
+            template <typename T>
+            struct soa_column<T, std::numeric_limits<size_t>::max()> {
+                template <size_t I> using type = std::vector<soa_element_t<typename type_wrapper<T, I>::type>>;
+            };
+
+            template <typename T, size_t ... Is>
+            struct soa_columns : RareTs::Class::adapt_member<soa_column<T>::template type, T, Is>... {};
+
+            template <typename T, bool IsConst, size_t I = std::numeric_limits<size_t>::max()>
+            struct soa_member_ref : RareTs::Class::adapt_member<soa_member_ref<T, IsConst>::template type, T, I> {};
+
+            template <typename T, bool IsConst>
+            struct soa_member_ref<T, IsConst, std::numeric_limits<size_t>::max()> {
+                template <size_t I> using type = std::conditional_t<IsConst,
+                    const typename type_wrapper<T, I>::type &, typename type_wrapper<T, I>::type &>;
+            };
+
+            template <typename Adapter> constexpr auto & adapted(Adapter & adapter) // Gets the sole member of a member adapter
+            {
+                auto & [value] = adapter;
+                return value;
+            }
+
+            template <typename U> constexpr auto & soa_element(U & element)
+            {
+                if constexpr ( std::is_same_v<soa_bool, std::remove_const_t<U>> )
+                    return element.value;
+                else
+                    return element;
+            }
+
+            template <typename T, bool IsConst, size_t ... Is>
+            struct soa_reference : RareTs::Class::adapt_member<soa_member_ref<T, IsConst>::template type, T, Is>...
+            {
+                using Columns = std::conditional_t<IsConst, const soa_columns<T, Is...>, soa_columns<T, Is...>>;
+
+                constexpr soa_reference(Columns & columns, size_t i) : RareTs::Class::adapt_member<soa_member_ref<T, IsConst>::template type, T, Is> {{
+                    soa_element(adapted(static_cast<std::conditional_t<IsConst, const RareTs::Class::adapt_member<soa_column<T>::template type, T, Is>,
+                        RareTs::Class::adapt_member<soa_column<T>::template type, T, Is>> &>(columns))[i]) }}... {}
+
+                constexpr soa_reference(const soa_reference &) = default;
+
+                constexpr soa_reference & operator=(const soa_reference & other) // Assigns the referenced values, not the references
+                {
+                    ((get<Is>() = other.template get<Is>()), ...);
+                    return *this;
+                }
+
+                constexpr soa_reference & operator=(const T & t)
+                {
+                    ((get<Is>() = RareTs::Member<T, Is>::value(t)), ...);
+                    return *this;
+                }
+
+                template <size_t I> constexpr auto & get() const
+                {
+                    return adapted(static_cast<const RareTs::Class::adapt_member<soa_member_ref<T, IsConst>::template type, T, I> &>(*this));
+                }
+
+                constexpr operator T() const
+                {
+                    T t {};
+                    ((RareTs::Member<T, Is>::value(t) = get<Is>()), ...);
+                    return t;
+                }
+            };
+
+            template <typename T, size_t ... Is> constexpr auto soa_columns_type(std::index_sequence<Is...>) -> soa_columns<T, Is...>;
+            template <typename T, bool IsConst, size_t ... Is> constexpr auto soa_reference_type(std::index_sequence<Is...>)
+                -> soa_reference<T, IsConst, Is...>;
+        }
+
+        template <typename T>
+        class soa_vector
+        {
+            template <size_t ... Is> static constexpr auto instanceData(std::index_sequence<Is...>)
+                -> typename RareTs::type_mask<RareTs::Filter::IsInstanceData, RareTs::Member<T, Is>...>::indexes;
+
+            using indexes = decltype(instanceData(std::make_index_sequence<RareTs::Members<T>::total>()));
+            using columns_type = decltype(detail::soa_columns_type<T>(indexes{}));
+
+            template <size_t I> constexpr auto & columnAt()
+            {
+                return detail::adapted(static_cast<RareTs::Class::adapt_member<detail::soa_column<T>::template type, T, I> &>(cols));
+            }
+            template <size_t I> constexpr auto & columnAt() const
+            {
+                return detail::adapted(static_cast<const RareTs::Class::adapt_member<detail::soa_column<T>::template type, T, I> &>(cols));
+            }
+
+            template <typename F, size_t ... Is> constexpr void forEachColumn(F && f, std::index_sequence<Is...>)
+            {
+                (f(columnAt<Is>()), ...);
+            }
+
+            template <bool IsConst>
+            class basic_iterator
+            {
+                using owner_type = std::conditional_t<IsConst, const soa_vector, soa_vector>;
+
+                owner_type* owner;
+                size_t index;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using reference = decltype(detail::soa_reference_type<T, IsConst>(indexes{}));
+                using pointer = void;
+
+                constexpr basic_iterator(owner_type* owner, size_t index) : owner(owner), index(index) {}
+
+                constexpr reference operator*() const { return (*owner)[index]; }
+                constexpr basic_iterator & operator++() { ++index; return *this; }
+                constexpr basic_iterator operator++(int) { basic_iterator prev = *this; ++index; return prev; }
+                constexpr bool operator==(const basic_iterator & other) const { return index == other.index; }
+                constexpr bool operator!=(const basic_iterator & other) const { return index != other.index; }
+            };
+
+            columns_type cols {};
+            size_t count = 0;
+
+        public:
+            using value_type = T;
+            using size_type = size_t;
+            using reference = decltype(detail::soa_reference_type<T, false>(indexes{}));
+            using const_reference = decltype(detail::soa_reference_type<T, true>(indexes{}));
+            using iterator = basic_iterator<false>;
+            using const_iterator = basic_iterator<true>;
+
+            constexpr size_t size() const noexcept { return count; }
+            constexpr bool empty() const noexcept { return count == 0; }
+
+            constexpr void reserve(size_t capacity) { forEachColumn([&](auto & column) { column.reserve(capacity); }, indexes{}); }
+            constexpr void resize(size_t size) { forEachColumn([&](auto & column) { column.resize(size); }, indexes{}); count = size; }
+            constexpr void clear() { forEachColumn([&](auto & column) { column.clear(); }, indexes{}); count = 0; }
+            constexpr void pop_back() { forEachColumn([&](auto & column) { column.pop_back(); }, indexes{}); --count; }
+
+            constexpr void push_back(const T & t)
+            {
+                RareTs::Members<T>::template forEach<RareTs::Filter::IsInstanceData>([&](auto member) {
+                    using Member = decltype(member);
+                    if constexpr ( std::is_same_v<bool, typename Member::type> )
+                        columnAt<Member::index>().push_back(soa_bool{member.value(t)});
+                    else
+                        columnAt<Member::index>().push_back(member.value(t));
+                });
+                ++count;
+            }
+
+            constexpr void push_back(T && t)
+            {
+                RareTs::Members<T>::template forEach<RareTs::Filter::IsInstanceData>([&](auto member) {
+                    using Member = decltype(member);
+                    if constexpr ( std::is_same_v<bool, typename Member::type> )
+                        columnAt<Member::index>().push_back(soa_bool{member.value(t)});
+                    else
+                        columnAt<Member::index>().push_back(std::move(member.value(t)));
+                });
+                ++count;
+            }
+
+            constexpr reference operator[](size_t i) { return reference(cols, i); }
+            constexpr const_reference operator[](size_t i) const { return const_reference(cols, i); }
+
+            constexpr reference at(size_t i)
+            {
+                if ( i >= count )
+                    throw std::out_of_range("soa_vector index out of range");
+                return reference(cols, i);
+            }
+            constexpr const_reference at(size_t i) const
+            {
+                if ( i >= count )
+                    throw std::out_of_range("soa_vector index out of range");
+                return const_reference(cols, i);
+            }
+
+            constexpr reference front() { return reference(cols, 0); }
+            constexpr const_reference front() const { return const_reference(cols, 0); }
+            constexpr reference back() { return reference(cols, count-1); }
+            constexpr const_reference back() const { return const_reference(cols, count-1); }
+
+            constexpr iterator begin() { return iterator(this, 0); }
+            constexpr const_iterator begin() const { return const_iterator(this, 0); }
+            constexpr iterator end() { return iterator(this, count); }
+            constexpr const_iterator end() const { return const_iterator(this, count); }
+
+            // The columns as read-only vectors named after the members of T, e.g. entities.columns().x
+            constexpr const columns_type & columns() const noexcept { return cols; }
+
+#ifndef RARE_NO_CPP_20
+            // A span over the column holding member I of T
+            template <size_t I> constexpr auto column() { return std::span(columnAt<I>()); }
+            template <size_t I> constexpr auto column() const { return std::span(columnAt<I>()); }
+
+            // A span over the column holding the given member, e.g. from RareTs::Members<T>::forEach
+            template <typename Member, typename = RareTs::enable_if_member_t<Member>> constexpr auto column(const Member &) {
+                return column<Member::index>();
+            }
+            template <typename Member, typename = RareTs::enable_if_member_t<Member>> constexpr auto column(const Member &) const {
+                return column<Member::index>();
+            }
+#endif
+        };
+    }
+}
+
+#endif
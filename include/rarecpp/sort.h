@@ -0,0 +1,258 @@
+// MIT License, Copyright (c) 2019-2025 Justin F https://github.com/TheNitesWhoSay/RareCpp/blob/master/LICENSE
+#ifndef SORT_H
+#define SORT_H
+#ifndef REFLECT_H
+#include "reflect.h"
+#endif
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Sorting of reflected records by member keys, e.g. "RareTs::sort_by<&Trade::day, &Trade::price>(trades);"
+//
+// Records are ordered lexicographically by the given data members (or by all instance data members in declaration order if none are given)
+// and sorts are stable; containers of at least radixSortThreshold records whose keys are all integral, enum, bool or IEEE floating point
+// have their keys packed into a contiguous array of order-preserving bytes which is LSD radix sorted along with source indexes, after which
+// each record is moved into its sorted position once; other sorts use std::stable_sort with RareTs::comparator
+namespace RareTs
+{
+    inline constexpr std::size_t radixSortThreshold = 1024; // Containers with fewer records than this are sorted by comparison
+
+    namespace SortBy::detail
+    {
+        template <typename T, typename Key> struct is_key_of { static constexpr bool value = false; };
+        template <typename T, typename C, typename M> struct is_key_of<T, M C::*> {
+            static constexpr bool value = !std::is_function_v<M> && std::is_base_of_v<C, T>;
+        };
+
+        template <typename T, auto Key> using key_type = std::remove_cvref_t<decltype(std::declval<const T &>().*Key)>;
+
+        template <typename K> inline constexpr bool isRadixKey = std::is_integral_v<K> || std::is_enum_v<K> ||
+            (std::is_floating_point_v<K> && std::numeric_limits<K>::is_iec559 && (sizeof(K) == sizeof(std::uint32_t) || sizeof(K) == sizeof(std::uint64_t)));
+
+        template <typename K> struct radix_bits {
+            using type = std::make_unsigned_t<std::conditional_t<std::is_same_v<K, bool>, std::uint8_t,
+                std::conditional_t<std::is_enum_v<K>, std::underlying_type_t<std::conditional_t<std::is_enum_v<K>, K, std::byte>>, K>>>;
+        };
+        template <> struct radix_bits<float> { using type = std::uint32_t; };
+        template <> struct radix_bits<double> { using type = std::uint64_t; };
+        template <typename K> using radix_bits_t = typename radix_bits<K>::type;
+
+        template <typename K> constexpr radix_bits_t<K> radixBits(K key) noexcept
+        { // Maps the key to an unsigned value which orders the same as the key did
+            using Bits = radix_bits_t<K>;
+            constexpr Bits signBit = Bits(Bits(1) << (std::numeric_limits<Bits>::digits-1));
+            if constexpr ( std::is_floating_point_v<K> )
+            {
+                Bits bits = std::bit_cast<Bits>(key == K(0) ? K(0) : key); // Negative zero orders equal to zero
+                return (bits & signBit) != 0 ? Bits(~bits) : Bits(bits | signBit);
+            }
+            else if constexpr ( std::is_enum_v<K> )
+                return radixBits(static_cast<std::underlying_type_t<K>>(key));
+            else if constexpr ( std::is_signed_v<K> )
+                return Bits(Bits(key) ^ signBit);
+            else
+                return Bits(key);
+        }
+
+        template <std::size_t Width, typename I> struct radix_entry
+        {
+            std::array<std::uint8_t, Width> key; // Most significant byte first
+            I index;
+        };
+
+        template <std::size_t Width, typename I> void radixSort(std::vector<radix_entry<Width, I>> & entries)
+        {
+            std::size_t total = entries.size();
+            std::vector<std::array<std::size_t, 256>> counts(Width, std::array<std::size_t, 256>{});
+            for ( const auto & entry : entries )
+            {
+                for ( std::size_t i=0; i<Width; ++i )
+                    ++counts[i][entry.key[i]];
+            }
+
+            std::vector<radix_entry<Width, I>> buffer(total);
+            for ( std::size_t i=Width; i-- > 0; ) // Least significant byte first, each pass is stable
+            {
+                auto & count = counts[i];
+                if ( std::find(count.begin(), count.end(), total) != count.end() )
+                    continue; // Every entry has the same byte here, pass wouldn't change the order
+
+                std::size_t offset = 0;
+                for ( auto & bucket : count )
+                    offset += std::exchange(bucket, offset);
+
+                for ( const auto & entry : entries )
+                    buffer[count[entry.key[i]]++] = entry;
+
+                std::swap(entries, buffer);
+            }
+        }
+
+        // Rearranges items such that the item at i is the item previously at sourceIndexes[i]
+        template <typename I, typename Container> void permute(Container & items, std::span<const I> sourceIndexes)
+        { // Gathering into sequential storage is markedly faster than following permutation cycles in place, which moves records at random
+            std::vector<RareTs::element_type_t<Container>> sorted {};
+            sorted.reserve(sourceIndexes.size());
+            for ( auto sourceIndex : sourceIndexes )
+                sorted.push_back(std::move(items[std::size_t(sourceIndex)]));
+
+            if constexpr ( std::is_same_v<Container, decltype(sorted)> )
+                std::swap(items, sorted);
+            else
+                std::move(sorted.begin(), sorted.end(), std::begin(items));
+        }
+    }
+
+    // Orders T lexicographically by the given data member pointers, or by all reflected instance data members if no keys are given
+    template <typename T, auto ... Keys>
+    struct comparator
+    {
+        static_assert((SortBy::detail::is_key_of<T, decltype(Keys)>::value && ...), "Keys must be pointers to data members of T");
+
+        using type = T;
+
+        // Whether keys can be packed for a radix sort, requires explicit keys so that key extraction needn't walk reflection
+        static constexpr bool radixable = sizeof...(Keys) > 0 && (SortBy::detail::isRadixKey<SortBy::detail::key_type<T, Keys>> && ...);
+
+        constexpr bool operator()(const T & lhs, const T & rhs) const
+        {
+            if constexpr ( sizeof...(Keys) > 0 )
+                return less<Keys...>(lhs, rhs);
+            else
+            {
+                static_assert(RareTs::is_reflected_v<T>, "Keys must be provided to compare types which aren't reflected");
+                int order = 0;
+                RareTs::Members<T>::template forEach<RareTs::Filter::IsInstanceData>(lhs, [&](auto & member, auto & value) {
+                    using Member = std::remove_cvref_t<decltype(member)>;
+                    if ( order == 0 )
+                    {
+                        const auto & other = Member::value(rhs);
+                        order = value < other ? -1 : (other < value ? 1 : 0);
+                    }
+                });
+                return order < 0;
+            }
+        }
+
+    private:
+        template <auto Key, auto ... Remaining> static constexpr bool less(const T & lhs, const T & rhs)
+        {
+            if constexpr ( sizeof...(Remaining) == 0 )
+                return lhs.*Key < rhs.*Key;
+            else if ( lhs.*Key < rhs.*Key )
+                return true;
+            else if ( rhs.*Key < lhs.*Key )
+                return false;
+            else
+                return less<Remaining...>(lhs, rhs);
+        }
+    };
+
+    namespace SortBy::detail
+    {
+        template <typename Compare> struct is_comparator { static constexpr bool value = false; };
+        template <typename T, auto ... Keys> struct is_comparator<comparator<T, Keys...>> { static constexpr bool value = true; };
+
+        template <bool Desc, typename I, typename T, auto ... Keys, typename Container>
+        std::vector<I> radixSortedIndexes(const Container & items, comparator<T, Keys...>)
+        {
+            constexpr std::size_t width = (sizeof(radix_bits_t<key_type<T, Keys>>) + ...);
+            std::vector<radix_entry<width, I>> entries(std::size(items));
+            std::size_t index = 0;
+            for ( const auto & item : items )
+            {
+                auto & entry = entries[index];
+                entry.index = static_cast<I>(index++);
+                std::size_t offset = 0;
+                ([&](auto bits) {
+                    for ( std::size_t i=sizeof(bits); i-- > 0; bits = decltype(bits)(bits >> 8) )
+                        entry.key[offset+i] = std::uint8_t(Desc ? ~bits : bits);
+
+                    offset += sizeof(bits);
+                }(radixBits(item.*Keys)), ...);
+            }
+
+            radixSort(entries);
+            std::vector<I> sourceIndexes(entries.size());
+            for ( std::size_t i=0; i<entries.size(); ++i )
+                sourceIndexes[i] = entries[i].index;
+
+            return sourceIndexes;
+        }
+    }
+
+    /// Stably sorts the items and returns a vector of source indexes, such that the item now at i was previously at sourceIndexes[i]
+    /// @param items the random-access container to sort
+    /// @param compare the ordering, large containers sorted by a RareTs::comparator with radixable keys are radix sorted
+    /// @return a vector of source indexes
+    template <bool Desc = false, typename I = std::size_t, typename Container, typename Compare>
+    [[nodiscard]] std::vector<I> tracked_sort_by(Container & items, const Compare & compare)
+    {
+        std::vector<I> sourceIndexes {};
+        if constexpr ( SortBy::detail::is_comparator<Compare>::value )
+        {
+            if constexpr ( Compare::radixable )
+            {
+                if ( std::size(items) >= radixSortThreshold )
+                    sourceIndexes = SortBy::detail::radixSortedIndexes<Desc, I>(items, compare);
+            }
+        }
+        if ( sourceIndexes.empty() && std::size(items) > 0 )
+        {
+            sourceIndexes.resize(std::size(items));
+            std::iota(sourceIndexes.begin(), sourceIndexes.end(), static_cast<I>(0));
+            std::stable_sort(sourceIndexes.begin(), sourceIndexes.end(), [&](I lhs, I rhs) {
+                if constexpr ( Desc )
+                    return compare(items[std::size_t(rhs)], items[std::size_t(lhs)]);
+                else
+                    return compare(items[std::size_t(lhs)], items[std::size_t(rhs)]);
+            });
+        }
+        SortBy::detail::permute(items, std::span<const I>(sourceIndexes));
+        return sourceIndexes;
+    }
+
+    // Stably sorts the items in ascending order by the given data members, e.g. "RareTs::sort_by<&Trade::day, &Trade::price>(trades);"
+    template <auto ... Keys, typename Container>
+    void sort_by(Container & items)
+    {
+        using Compare = comparator<RareTs::element_type_t<Container>, Keys...>;
+        if ( Compare::radixable && std::size(items) >= radixSortThreshold )
+        {
+            if ( std::size(items) <= std::size_t(std::numeric_limits<std::uint32_t>::max()) )
+                (void)tracked_sort_by<false, std::uint32_t>(items, Compare{}); // Smaller indexes make for smaller radix entries
+            else
+                (void)tracked_sort_by<false>(items, Compare{});
+        }
+        else
+            std::stable_sort(std::begin(items), std::end(items), Compare{});
+    }
+
+    // Stably sorts the items in descending order by the given data members
+    template <auto ... Keys, typename Container>
+    void sort_by_desc(Container & items)
+    {
+        using Compare = comparator<RareTs::element_type_t<Container>, Keys...>;
+        if ( Compare::radixable && std::size(items) >= radixSortThreshold )
+        {
+            if ( std::size(items) <= std::size_t(std::numeric_limits<std::uint32_t>::max()) )
+                (void)tracked_sort_by<true, std::uint32_t>(items, Compare{}); // Smaller indexes make for smaller radix entries
+            else
+                (void)tracked_sort_by<true>(items, Compare{});
+        }
+        else
+            std::stable_sort(std::begin(items), std::end(items), [](const auto & lhs, const auto & rhs) { return Compare{}(rhs, lhs); });
+    }
+}
+
+#endif
@@ -1,18 +1,33 @@
 // MIT License, Copyright (c) 2019-2025 Justin F https://github.com/TheNitesWhoSay/RareCpp/blob/master/LICENSE
 #ifndef STRINGBUFFER_H
 #define STRINGBUFFER_H
+#include <algorithm>
 #include <array>
 #include <charconv>
+#include <cstddef>
 #include <cstring>
 #include <functional>
 #include <ios>
 #include <istream>
+#include <limits>
 #include <memory>
+#include <memory_resource>
 #include <ostream>
+#include <stdexcept>
 #include <streambuf>
 #include <string>
+#include <string_view>
 #include <system_error>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#if __has_include(<sys/uio.h>)
+#include <cerrno>
+#include <climits>
+#include <sys/uio.h>
+#include <unistd.h>
+#define RARE_HAS_WRITEV
+#endif
 
 namespace RareBufferedStream
 {
@@ -22,79 +37,128 @@ namespace RareBufferedStream
     };
     struct Os {};
 
+    // An allocator whose value-construction leaves chars uninitialized, so resizing a vector to write into it doesn't zero-fill it first;
+    // allocation is left to Base (e.g. a std::pmr::polymorphic_allocator)
+    template <typename T, typename Base = std::allocator<T>>
+    struct DefaultInitAllocator : Base
+    {
+        template <typename U> struct rebind {
+            using other = DefaultInitAllocator<U, typename std::allocator_traits<Base>::template rebind_alloc<U>>;
+        };
+
+        DefaultInitAllocator() noexcept(std::is_nothrow_default_constructible_v<Base>) = default;
+        DefaultInitAllocator(const Base & base) noexcept : Base(base) {}
+        template <typename U, typename B> DefaultInitAllocator(const DefaultInitAllocator<U, B> & other) noexcept : Base(other) {}
+
+        template <typename U> void construct(U* p) noexcept(std::is_nothrow_default_constructible_v<U>) { ::new(static_cast<void*>(p)) U; }
+        template <typename U, typename ... Args> void construct(U* p, Args && ... args) { ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+    };
+
     // A faster alternative to std::stringstream; can similarly be used as both an ostream or istream,
     // streaming to a StringBuffer with the << operator will occur much faster than to the ostream,
     // although all stream flags will be ignored; to stream to ostream as regular with stream flags applied
     // and less enhanced performance, cast to a ostream reference or use the "os" stream manipulator;
     // you can stream objects that overload ostream/istream with StringBuffer as usual, stream flags will apply,
     // though overloading streaming to StringBuffer can improve object streaming speed
-    template <typename StreamType>
+    // Allocator may be e.g. std::pmr::polymorphic_allocator<char> (see RareBufferedStream::pmr) to place the buffer in a memory resource
+    template <typename StreamType, typename Allocator = std::allocator<char>>
     class BasicStringBuffer : public std::streambuf, public StreamType
     {
         public:
             static constexpr EndL endl = {}; // Use StringBuffer::endl instead of std::endl to improve performance
             static constexpr Os os = {}; // Use this stream manipulator to start streaming as if to std::ostream, avoid this to improve performance
 
-            BasicStringBuffer() : StreamType((std::streambuf*)this), inputInitialized(false), src(nullptr), num() {}
-            BasicStringBuffer(std::istream & source) : StreamType((std::streambuf*)this), inputInitialized(false), src(&source), num() {}
+            BasicStringBuffer() : StreamType((std::streambuf*)this), inputInitialized(false), src(nullptr) {}
+            BasicStringBuffer(std::istream & source) : StreamType((std::streambuf*)this), inputInitialized(false), src(&source) {}
             BasicStringBuffer(const std::string & str) : StreamType((std::streambuf*)this),
-                inputInitialized(false), src(nullptr), num(), data(str.begin(), str.end()) {}
+                inputInitialized(false), src(nullptr), data(str.begin(), str.end()) {}
             BasicStringBuffer(const std::string & str, std::istream & source) : StreamType((std::streambuf*)this),
-                inputInitialized(false), src(&source), num(), data(str.begin(), str.end()) {}
+                inputInitialized(false), src(&source), data(str.begin(), str.end()) {}
+            BasicStringBuffer(const Allocator & allocator) : StreamType((std::streambuf*)this),
+                inputInitialized(false), src(nullptr), chunks(allocator), data(allocator), rawTail(allocator) {}
+            BasicStringBuffer(const std::string & str, const Allocator & allocator) : StreamType((std::streambuf*)this),
+                inputInitialized(false), src(nullptr), chunks(allocator), data(str.begin(), str.end(), allocator), rawTail(allocator) {}
 
-            virtual ~BasicStringBuffer() {}
+            virtual ~BasicStringBuffer()
+            {
+                if ( sinkAttached() )
+                    detachSink();
+            }
 
             // Append text as-is using the += operator
             inline void operator+=(const char & c)
             {
+                prepareAppend(1);
                 data.push_back(c);
             }
             template <size_t N> inline void operator+=(const char (& str)[N])
             {
-                data.insert(data.end(), &str[0], &str[N-1]);
+                append(&str[0], N-1);
             }
             inline void operator+=(const char* str)
             {
-                data.insert(data.end(), str, str+std::strlen(str)*sizeof(char));
+                append(str, std::strlen(str));
             }
             inline void operator+=(const std::string & str)
             {
-                data.insert(data.end(), str.begin(), str.end());
+                append(str.data(), str.size());
             }
             
             // Append text as-is using ostream operators
             inline BasicStringBuffer & operator<<(const char & c)
             {
+                prepareAppend(1);
                 data.push_back(c);
                 return *this;
             }
             template <size_t N> inline BasicStringBuffer & operator<<(const char (& str)[N])
             {
-                data.insert(data.end(), &str[0], &str[N-1]);
+                append(&str[0], N-1);
                 return *this;
             }
             inline BasicStringBuffer & operator<<(const char* str)
             {
-                data.insert(data.end(), str, str+std::strlen(str)*sizeof(char));
+                append(str, std::strlen(str));
                 return *this;
             }
             inline BasicStringBuffer & operator<<(const std::string & str)
             {
-                data.insert(data.end(), str.begin(), str.end());
+                append(str.data(), str.size());
                 return *this;
             }
         
+            // Raw appends: reserveRaw returns a pointer to maxLength uninitialized chars (a scratch tail kept apart from the buffer and
+            // reused, so nothing is zero-filled), the chars are written there and commitRaw then appends the first length (at most
+            // maxLength) of them, avoiding per-char capacity checks; the reserved chars are only valid until commitRaw and no other appends
+            // may be made in between; raw chars are never split across chunks
+            inline char* reserveRaw(size_t maxLength)
+            {
+                prepareAppend(maxLength);
+                if ( rawTail.size() < maxLength )
+                    rawTail.resize(maxLength); // Not zero-filled, see DefaultInitAllocator
+                return rawTail.data();
+            }
+            inline void commitRaw(size_t length)
+            {
+                data.insert(data.end(), rawTail.data(), rawTail.data()+length);
+            }
+
             // Append regular base-10 numbers
             template <typename T>
             inline BasicStringBuffer & appendNumber(const T & value) {
+                constexpr size_t maxLength = std::is_integral_v<T> ? size_t(std::numeric_limits<T>::digits10)+3 : // Sign & partial digit
+                    size_t(std::numeric_limits<T>::max_digits10)+12; // Sign, point & exponent
+                char* out = reserveRaw(maxLength);
                 if constexpr ( std::is_same_v<bool, T> )
                 {
-                    if ( auto [p, ec] = std::to_chars((char*)num.data(), (char*)num.data() + num.size(), (int)value); ec == std::errc() )
-                        data.insert(data.end(), num.data(), p);
+                    auto [p, ec] = std::to_chars(out, out+maxLength, (int)value);
+                    commitRaw(ec == std::errc() ? size_t(p-out) : 0);
+                }
+                else
+                {
+                    auto [p, ec] = std::to_chars(out, out+maxLength, value);
+                    commitRaw(ec == std::errc() ? size_t(p-out) : 0);
                 }
-                else if ( auto [p, ec] = std::to_chars((char*)num.data(), (char*)num.data() + num.size(), value); ec == std::errc() )
-                    data.insert(data.end(), num.data(), p);
-
                 return *this;
             }
             
@@ -160,18 +224,26 @@ namespace RareBufferedStream
         
             size_t size() const noexcept
             {
-                return data.size();
+                return chunks.empty() ? data.size() : totalSize();
             }
 
             inline void clear()
             {
                 data.clear();
+                chunks.clear();
                 ((std::ostream*)this)->clear();
                 ((std::istream*)this)->clear();
             }
 
             const char & operator[](size_t pos) const
             {
+                for ( const auto & chunk : chunks )
+                {
+                    if ( pos < chunk.size() )
+                        return chunk[pos];
+                    else
+                        pos -= chunk.size();
+                }
                 return data[pos];
             }
 
@@ -180,6 +252,7 @@ namespace RareBufferedStream
             // a NUL terminator in the middle of string
             inline const char* c_str(bool addNulTerminator = true)
             {
+                requireContiguous("c_str");
                 if ( addNulTerminator )
                     nullTerminate();
 
@@ -188,21 +261,208 @@ namespace RareBufferedStream
 
             inline std::string str() const
             {
-                return std::string(data.begin(), data.end());
+                if ( chunks.empty() )
+                    return std::string(data.begin(), data.end());
+
+                std::string result;
+                result.reserve(totalSize());
+                for ( const auto & span : spans() )
+                    result.append(span);
+                return result;
             }
 
-            inline const std::vector<char> & vec() const
+            // Chunked output: once enabled, output is appended to fixed-capacity chunks and a chunk that would overflow is set aside
+            // (without copying) in favor of a new one, so written chars are never moved by reallocation and there is no doubling of peak
+            // memory for large outputs; appends larger than a chunk are split across chunks; size/operator[]/totalSize/spans/str/writeTo
+            // cover all output, whereas c_str/vec throw std::logic_error once a chunk has been set aside as the output is no longer
+            // contiguous; seeking refers to the current (last) chunk; chunked mode is meant for output only
+            inline void enableChunks(size_t chunkSize = defaultChunkSize)
+            {
+                this->chunkSize = chunkSize;
+                data.reserve(chunkSize);
+            }
+
+            inline bool chunked() const noexcept
             {
+                return chunkSize > 0 && !sinkAttached();
+            }
+
+            // Sink mode: whenever an append would take the buffer past highWaterMark the buffered output is written to the sink and the
+            // buffer emptied, so memory use stays constant and the sink receives output while serialization continues; the appends
+            // themselves are unchanged (a size check, no virtual calls); remaining output is written by flushSink or on destruction;
+            // the buffer grows as needed up to highWaterMark, so small outputs don't allocate a whole high-water mark
+            inline void attachSink(std::ostream & sink, size_t highWaterMark = defaultChunkSize)
+            {
+                resetSink();
+                sinkStream = &sink;
+                sinkHighWaterMark = highWaterMark;
+            }
+
+#ifdef RARE_HAS_WRITEV
+            inline void attachSink(int fd, size_t highWaterMark = defaultChunkSize)
+            {
+                resetSink();
+                sinkFd = fd;
+                sinkHighWaterMark = highWaterMark;
+            }
+#endif
+
+            // Fixed-span sink: buffered output is copied into the caller-owned chars at output, output beyond capacity is discarded (but
+            // still counted by sinkWritten) and sets badbit
+            inline void attachSink(char* output, size_t capacity, size_t highWaterMark = defaultChunkSize)
+            {
+                resetSink();
+                memorySink = MemorySink::Span;
+                spanSink = output;
+                spanSinkCapacity = capacity;
+                sinkHighWaterMark = highWaterMark;
+            }
+
+            // Counting sink: buffered output is discarded, only the number of chars written is kept (see sinkWritten), so that the size of
+            // output can be measured while the buffer never grows beyond highWaterMark
+            inline void attachCountingSink(size_t highWaterMark = defaultChunkSize)
+            {
+                resetSink();
+                memorySink = MemorySink::Counting;
+                sinkHighWaterMark = highWaterMark;
+            }
+
+            // Writes any remaining output to the sink (flushing an ostream sink) and detaches it, chunked output resumes if it was enabled
+            // before attaching
+            inline void detachSink()
+            {
+                flushSink();
+                if ( sinkStream != nullptr && sinkStream->flush().fail() )
+                    ((std::ostream*)this)->setstate(std::ios_base::badbit);
+
+                sinkStream = nullptr;
+                sinkFd = -1;
+                memorySink = MemorySink::None;
+                sinkHighWaterMark = 0;
+            }
+
+            inline bool sinkAttached() const noexcept
+            {
+                return sinkStream != nullptr || sinkFd >= 0 || memorySink != MemorySink::None;
+            }
+
+            // The number of chars flushed to the sink since it was last attached, remains available after the sink is detached
+            inline size_t sinkWritten() const noexcept
+            {
+                return sinkWrittenTotal;
+            }
+
+            // Writes buffered output to the sink (if attached), leaving the buffer empty; an ostream sink is only flushed on detachSink
+            inline void flushSink()
+            {
+                if ( sinkStream != nullptr )
+                {
+                    size_t total = totalSize();
+                    writeTo(*sinkStream);
+                    if ( sinkStream->fail() )
+                        ((std::ostream*)this)->setstate(std::ios_base::badbit);
+                    else
+                        sinkWrittenTotal += total;
+                }
+#ifdef RARE_HAS_WRITEV
+                else if ( sinkFd >= 0 )
+                {
+                    size_t total = totalSize();
+                    if ( writeTo(sinkFd) )
+                        sinkWrittenTotal += total;
+                    else
+                        ((std::ostream*)this)->setstate(std::ios_base::badbit);
+                }
+#endif
+                else if ( memorySink != MemorySink::None )
+                {
+                    for ( const auto & chunk : chunks )
+                        writeToMemorySink(chunk.data(), chunk.size());
+
+                    writeToMemorySink(data.data(), data.size());
+                    chunks.clear();
+                    data.clear();
+                    syncOutput();
+                }
+            }
+
+            size_t totalSize() const noexcept
+            {
+                size_t total = data.size();
+                for ( const auto & chunk : chunks )
+                    total += chunk.size();
+                return total;
+            }
+
+            // Views of all output in order (the completed chunks followed by the current chunk), valid until the buffer is next modified
+            inline std::vector<std::string_view> spans() const
+            {
+                std::vector<std::string_view> result;
+                result.reserve(chunks.size()+1);
+                for ( const auto & chunk : chunks )
+                    result.emplace_back(chunk.data(), chunk.size());
+                if ( !data.empty() )
+                    result.emplace_back(data.data(), data.size());
+                return result;
+            }
+
+            // Writes all output to os and empties the buffer (keeping the capacity of the current chunk)
+            inline void writeTo(std::ostream & os)
+            {
+                for ( const auto & span : spans() )
+                    os.write(span.data(), std::streamsize(span.size()));
+
+                chunks.clear();
+                data.clear();
+                syncOutput();
+            }
+
+#ifdef RARE_HAS_WRITEV
+            // Writes all output to a file descriptor using gathered writes and empties the buffer, returns false if a write fails
+            inline bool writeTo(int fd)
+            {
+                std::vector<std::string_view> pending = spans();
+                std::vector<iovec> iov(pending.size());
+                size_t first = 0;
+                while ( first < pending.size() )
+                {
+                    size_t count = std::min(pending.size()-first, size_t(IOV_MAX));
+                    for ( size_t i=0; i<count; ++i )
+                        iov[i] = iovec { const_cast<char*>(pending[first+i].data()), pending[first+i].size() };
+
+                    ssize_t written = ::writev(fd, iov.data(), int(count));
+                    if ( written < 0 && errno == EINTR )
+                        continue;
+                    else if ( written < 0 )
+                        return false;
+
+                    size_t remaining = size_t(written);
+                    for ( ; first < pending.size() && remaining >= pending[first].size(); ++first )
+                        remaining -= pending[first].size(); // Drop fully written spans
+
+                    if ( first < pending.size() )
+                        pending[first].remove_prefix(remaining); // Resume partially written span
+                }
+                chunks.clear();
+                data.clear();
+                syncOutput();
+                return true;
+            }
+#endif
+
+            inline const std::vector<char, Allocator> & vec() const
+            {
+                requireContiguous("vec");
                 return data;
             }
 
-            inline void swap(std::vector<char> & other)
+            inline void swap(std::vector<char, Allocator> & other)
             {
                 data.swap(other);
                 sync();
             }
 
-            inline void swap(BasicStringBuffer<StreamType> & other)
+            inline void swap(BasicStringBuffer & other)
             {
                 data.swap(other.data);
                 sync();
@@ -222,6 +482,38 @@ namespace RareBufferedStream
             }
 
         protected:
+            inline void resetSink() noexcept
+            {
+                sinkStream = nullptr;
+                sinkFd = -1;
+                memorySink = MemorySink::None;
+                sinkWrittenTotal = 0;
+            }
+
+            inline void writeToMemorySink(const char* chars, size_t length)
+            {
+                if ( memorySink == MemorySink::Span )
+                {
+                    size_t fits = sinkWrittenTotal < spanSinkCapacity ? std::min(length, spanSinkCapacity-sinkWrittenTotal) : 0;
+                    if ( fits > 0 )
+                        std::memcpy(spanSink+sinkWrittenTotal, chars, fits);
+                    if ( fits < length )
+                        ((std::ostream*)this)->setstate(std::ios_base::badbit);
+                }
+                sinkWrittenTotal += length;
+            }
+
+            inline void requireContiguous(const char* accessor) const
+            {
+                if ( !chunks.empty() )
+                    throw std::logic_error(std::string(accessor) + " is unavailable once output is split into chunks, use str, spans or writeTo");
+            }
+
+            inline size_t appendLimit() const noexcept
+            {
+                return sinkAttached() ? sinkHighWaterMark : chunkSize;
+            }
+
             // Returns true if gptr points to a valid next character, false otherwise
             inline bool syncInput()
             {
@@ -331,10 +623,16 @@ namespace RareBufferedStream
                         pbump(1);
                     }
                     else
+                    {
+                        prepareAppend(1);
                         data.push_back((char)c);
+                    }
                 }
                 else
+                {
+                    prepareAppend(1);
                     data.push_back((char)c);
+                }
 
                 return c;
             }
@@ -442,11 +740,63 @@ namespace RareBufferedStream
                 return seekoff(std::streambuf::off_type(sp), std::ios_base::beg, which);
             }
 
+            // Called before appending length chars; if length chars would not fit in the current chunk, flushes to the sink in sink mode or
+            // sets aside the current chunk in chunked mode
+            inline void prepareAppend(size_t length)
+            {
+                if ( size_t limit = appendLimit(); limit > 0 && data.size()+length > limit && !data.empty() )
+                    nextChunkOrFlush();
+            }
+
+            inline void nextChunkOrFlush()
+            {
+                if ( sinkAttached() )
+                    flushSink();
+                else
+                    nextChunk();
+            }
+
+            // Appends length chars from str, chars that wouldn't fit in a single chunk (or under the sink high-water mark) are split across
+            // as many full chunks as needed
+            inline void append(const char* str, size_t length)
+            {
+                prepareAppend(length);
+                for ( size_t limit = appendLimit(); limit > 0 && length > limit; length -= limit, str += limit )
+                {
+                    data.insert(data.end(), str, str+limit); // data is empty after prepareAppend and each nextChunkOrFlush
+                    nextChunkOrFlush();
+                }
+                data.insert(data.end(), str, str+length);
+            }
+
+            void nextChunk()
+            {
+                auto allocator = data.get_allocator();
+                chunks.push_back(std::move(data));
+                data = std::vector<char, Allocator>(allocator);
+                data.reserve(chunkSize);
+                syncOutput();
+            }
+
         private:
+            static constexpr size_t defaultChunkSize = 1024*1024;
+
             bool inputInitialized;
             std::istream* src;
-            std::array<char, 256> num;
-            std::vector<char> data;
+            size_t chunkSize = 0; // 0 unless chunked output is enabled
+            size_t sinkHighWaterMark = 0; // 0 unless a sink is attached
+            enum class MemorySink { None, Counting, Span };
+
+            std::ostream* sinkStream = nullptr;
+            int sinkFd = -1;
+            MemorySink memorySink = MemorySink::None;
+            char* spanSink = nullptr;
+            size_t spanSinkCapacity = 0;
+            size_t sinkWrittenTotal = 0; // Chars flushed to the sink since it was attached
+            std::vector<std::vector<char, Allocator>, typename std::allocator_traits<Allocator>::template rebind_alloc<std::vector<char, Allocator>>>
+                chunks; // Completed chunks of output (chunked mode)
+            std::vector<char, Allocator> data;
+            std::vector<char, DefaultInitAllocator<char, Allocator>> rawTail; // The chars handed out by reserveRaw
     };
 
     template <>
@@ -460,6 +810,17 @@ namespace RareBufferedStream
             BasicStringBuffer(const std::string & str, std::istream & source) : std::istream((std::streambuf*)this), std::ostream((std::streambuf*)this),
                 inputInitialized(false), src(&source), data(str.begin(), str.end()) {}
 
+            // Windowed input: rather than draining the whole source, reads at most windowSize chars from source at a time and releases
+            // consumed chars on each refill, keeping up to putbackSize consumed chars available for unget/putback; memory use is then
+            // bounded by windowSize+putbackSize regardless of the size of the source; size/str/vec/operator[] refer to the current window
+            // and seeking relative to the end fails until the source has been read to its end
+            BasicStringBuffer(std::istream & source, size_t windowSize, size_t putbackSize = defaultPutbackSize)
+                : std::istream((std::streambuf*)this), std::ostream((std::streambuf*)this), inputInitialized(false), src(&source),
+                windowSize(windowSize), putbackSize(putbackSize)
+            {
+                data.reserve(windowSize+putbackSize);
+            }
+
             virtual ~BasicStringBuffer() {}
 
             inline void operator<<(std::streambuf* sb)
@@ -469,23 +830,26 @@ namespace RareBufferedStream
             
             inline void nullTerminate()
             {
+                trimSlack();
                 if ( data.empty() || data.back() != '\0' )
                     data.push_back('\0');
             }
             inline void unterminate()
             {
+                trimSlack();
                 if ( !data.empty() && data.back() == '\0' )
                     data.pop_back();
             }
         
             size_t size() const noexcept
             {
-                return data.size();
+                return data.size()-slack;
             }
 
             inline void clear()
             {
                 data.clear();
+                slack = 0;
                 ((std::ostream*)this)->clear();
                 ((std::istream*)this)->clear();
             }
@@ -508,16 +872,18 @@ namespace RareBufferedStream
 
             inline std::string str() const
             {
-                return std::string(data.begin(), data.end());
+                return std::string(data.begin(), data.begin()+std::ptrdiff_t(size()));
             }
 
             inline const std::vector<char> & vec() const
             {
+                trimSlack();
                 return data;
             }
 
             inline void swap(std::vector<char> & other)
             {
+                trimSlack();
                 data.swap(other);
                 sync();
             }
@@ -534,14 +900,68 @@ namespace RareBufferedStream
                 return src;
             }
 
+            // The number of chars released from the front of the buffer in windowed mode (the source offset of the first buffered char)
+            size_t discardedSize() const noexcept
+            {
+                return discarded;
+            }
+
         protected:
+            // Drops the unused chars past the end of the window so that data can be exposed or modified directly
+            inline void trimSlack() const
+            {
+                if ( slack > 0 )
+                {
+                    data.resize(data.size()-slack);
+                    slack = 0;
+                }
+            }
+
+            // Windowed mode: releases consumed chars except for the putback reserve, then appends up to windowSize chars from the source;
+            // data is sized to hold a full window once and is not resized by later refills (the unused chars are tracked by slack), so
+            // refills don't zero-fill chars that are about to be read over
+            inline void refill(std::ptrdiff_t & offset)
+            {
+                size_t valid = size();
+                size_t consumed = std::min(size_t(offset), valid);
+                size_t release = consumed - std::min(consumed, putbackSize);
+                if ( release > 0 )
+                {
+                    std::memmove(data.data(), data.data()+release, valid-release);
+                    valid -= release;
+                    discarded += release;
+                    offset -= std::ptrdiff_t(release);
+                }
+
+                if ( data.size() < valid+windowSize )
+                    data.resize(valid+windowSize);
+
+                std::streamsize count = src->rdbuf()->sgetn(&data[valid], std::streamsize(windowSize));
+                valid += size_t(count > 0 ? count : 0);
+                slack = data.size()-valid;
+                sourceExhausted = count < std::streamsize(windowSize); // sgetn only returns fewer chars than requested at the end of the source
+            }
+
+            inline bool sourceReadable() const
+            {
+                return src != nullptr && src->good() && !sourceExhausted;
+            }
+
             // Returns true if gptr points to a valid next character, false otherwise
             inline bool syncInput()
             {
                 auto eback = std::streambuf::eback(); // Input start
                 auto gptr = std::streambuf::gptr(); // Input curr
                 auto egptr = std::streambuf::egptr(); // Input end
-                auto size = data.size()*sizeof(char);
+                auto size = this->size()*sizeof(char);
+
+                if ( size == 0 && windowSize > 0 && sourceReadable() ) // Read the first window (or the next window if none was kept)
+                {
+                    std::ptrdiff_t offset = 0;
+                    refill(offset);
+                    size = this->size()*sizeof(char);
+                    inputInitialized = false;
+                }
 
                 if ( size == 0 )
                 {
@@ -556,11 +976,21 @@ namespace RareBufferedStream
                     if ( inputInitialized && eback != nullptr && gptr != nullptr && egptr != nullptr && gptr >= eback && gptr <= egptr )
                     {
                         auto offset = gptr-eback; // Calculate the offset, apply offset to the current data set
-                        if ( offset >= (decltype(offset))size && (src != nullptr && src->good()) ) // Input offset was at end of vector or further
+                        if ( offset >= (decltype(offset))size && sourceReadable() ) // Input offset was at end of vector or further
                         {
-                            *this << src->rdbuf(); // Try reading from source stream
+                            if ( windowSize > 0 )
+                                refill(offset); // Read the next window from source stream
+                            else
+                                *this << src->rdbuf(); // Try reading from source stream
+
+                            if ( this->size() == 0 )
+                            {
+                                setg(nullptr, nullptr, nullptr);
+                                inputInitialized = false;
+                                return false; // No characters available
+                            }
                             start = &data[0];
-                            size = data.size()*sizeof(char);
+                            size = this->size()*sizeof(char);
                         }
 
                         if ( size_t(offset) == size ) // Input position is at the end of the vector
@@ -596,15 +1026,15 @@ namespace RareBufferedStream
                 auto pbase = std::streambuf::pbase(); // Output start
                 auto pptr = std::streambuf::pptr(); // Output curr
                 auto epptr = std::streambuf::epptr(); // Output end
-                auto size = data.size()*sizeof(char);
+                auto size = this->size()*sizeof(char);
 
                 if ( pbase != nullptr && pptr != nullptr && epptr != nullptr && pptr >= pbase && pptr < epptr ) // At some valid, non-end position
                 {
                     auto offset = pptr-pbase; // Calculate the offset, apply offset to the current data set
-                    if ( offset >= (decltype(offset))size && (src != nullptr && src->good()) ) // Output offset was at end of vector or further
+                    if ( windowSize == 0 && offset >= (decltype(offset))size && (src != nullptr && src->good()) ) // Output offset was at end of vector or further
                     {
                         *this << src->rdbuf(); // Try reading from source stream
-                        size = data.size()*sizeof(char);
+                        size = this->size()*sizeof(char);
                     }
 
                     if ( offset >= (decltype(offset))size ) // Output position is at the end of the vector or out of bounds due to vector size reduction
@@ -635,6 +1065,7 @@ namespace RareBufferedStream
             // Appends the character that came through std::ostream
             virtual int overflow(int c)
             {
+                trimSlack();
                 if ( pptr() < epptr() && pptr() != nullptr && epptr() != nullptr )
                 {
                     syncOutput();
@@ -681,6 +1112,7 @@ namespace RareBufferedStream
                 else if ( s != nullptr && n > 0 )
                 {
                     data.assign(s, s+n);
+                    slack = 0;
                     inputInitialized = false;
                     syncInput();
                 }
@@ -708,13 +1140,15 @@ namespace RareBufferedStream
                         if ( repositionRead )
                         {
                             if ( dir == std::ios_base::beg )
-                                newInputOffset = 0;
+                                newInputOffset = -std::streambuf::off_type(discarded); // Absolute positions include released chars
                             else if ( dir == std::ios_base::cur )
                                 newInputOffset = gptr()-eback();
+                            else if ( dir == std::ios_base::end && windowSize > 0 && sourceReadable() )
+                                return std::streambuf::pos_type(std::streambuf::off_type(-1)); // The end of the source isn't known yet
                             else if ( dir == std::ios_base::end )
-                                newInputOffset = std::streamoff(data.size()*sizeof(char));
+                                newInputOffset = std::streamoff(size()*sizeof(char));
 
-                            if ( newInputOffset + off < 0 || &data[0] + newInputOffset + off > &data[0]+data.size()*sizeof(char) )
+                            if ( newInputOffset + off < 0 || &data[0] + newInputOffset + off > &data[0]+size()*sizeof(char) )
                                 return std::streambuf::pos_type(std::streambuf::off_type(-1));
                         }
 
@@ -725,19 +1159,19 @@ namespace RareBufferedStream
                             else if ( dir == std::ios_base::cur )
                                 newOutputOffset = pptr()-pbase();
                             else if ( dir == std::ios_base::end )
-                                newOutputOffset = std::streamoff(data.size()*sizeof(char));
+                                newOutputOffset = std::streamoff(size()*sizeof(char));
 
                             if ( newOutputOffset + off < 0 || &data[0] + newOutputOffset + off > epptr() )
                                 return std::streambuf::pos_type(std::streambuf::off_type(-1));
                         }
 
                         if ( repositionRead )
-                            setg(&data[0], &data[0]+newInputOffset+off, &data[0]+data.size()*sizeof(char));
+                            setg(&data[0], &data[0]+newInputOffset+off, &data[0]+size()*sizeof(char));
 
                         if ( repositionWrite )
-                            setp(&data[0]+newOutputOffset+off, &data[0]+data.size()*sizeof(char));
+                            setp(&data[0]+newOutputOffset+off, &data[0]+size()*sizeof(char));
 
-                        return std::streambuf::pos_type(repositionRead ? newInputOffset : newOutputOffset);
+                        return std::streambuf::pos_type(repositionRead ? std::streambuf::off_type(discarded)+newInputOffset : newOutputOffset);
                     }
                 }
                 return std::streambuf::pos_type(std::streambuf::off_type(-1));
@@ -750,22 +1184,117 @@ namespace RareBufferedStream
             }
 
         private:
+            static constexpr size_t defaultPutbackSize = 16;
+
             bool inputInitialized;
             std::istream* src;
-            std::vector<char> data;
+            size_t windowSize = 0; // 0 for unbounded (the entire source is read in on underflow)
+            size_t putbackSize = 0;
+            size_t discarded = 0;
+            bool sourceExhausted = false; // Set once a windowed read reaches the end of the source, which is then not polled again
+            mutable std::vector<char> data; // Mutable so that vec can drop the slack
+            mutable size_t slack = 0; // Windowed mode: the number of unused chars at the end of data, past the end of the window
+    };
+
+    // A read-only istream whose get area points directly at caller-owned chars (e.g. a std::string_view or a memory-mapped file),
+    // nothing is copied into the buffer so the chars must outlive it; view() exposes the underlying chars for fast paths
+    class ViewStringBuffer : public std::streambuf, public std::istream
+    {
+        public:
+            ViewStringBuffer() : std::istream((std::streambuf*)this) {}
+            ViewStringBuffer(std::string_view view) : std::istream((std::streambuf*)this) { reset(view); }
+
+            virtual ~ViewStringBuffer() {}
+
+            // Points the buffer at a new range of chars and rewinds to the start of that range
+            inline void reset(std::string_view view)
+            {
+                char* begin = const_cast<char*>(view.data()); // The get area is never written to
+                setg(begin, begin, begin+view.size());
+                ((std::istream*)this)->clear();
+            }
+
+            size_t size() const noexcept
+            {
+                return size_t(egptr()-eback());
+            }
+
+            // All chars in the buffer
+            inline std::string_view view() const noexcept
+            {
+                return std::string_view(eback(), size());
+            }
+
+            // The chars not yet read
+            inline std::string_view remaining() const noexcept
+            {
+                return std::string_view(gptr(), size_t(egptr()-gptr()));
+            }
+
+            inline std::string str() const
+            {
+                return std::string(view());
+            }
+
+        protected:
+            virtual std::streambuf::pos_type seekoff(std::streambuf::off_type off, std::ios_base::seekdir dir,
+                std::ios_base::openmode which = std::ios_base::in | std::ios_base::out)
+            {
+                if ( (which & std::ios_base::in) == std::ios_base::in )
+                {
+                    std::streambuf::off_type base = 0;
+                    if ( dir == std::ios_base::cur )
+                        base = gptr()-eback();
+                    else if ( dir == std::ios_base::end )
+                        base = egptr()-eback();
+
+                    if ( base + off >= 0 && base + off <= egptr()-eback() )
+                    {
+                        setg(eback(), eback()+base+off, egptr());
+                        return std::streambuf::pos_type(base+off);
+                    }
+                }
+                return std::streambuf::pos_type(std::streambuf::off_type(-1));
+            }
+
+            virtual std::streambuf::pos_type seekpos(std::streambuf::pos_type sp,
+                std::ios_base::openmode which = std::ios_base::in | std::ios_base::out)
+            {
+                return seekoff(std::streambuf::off_type(sp), std::ios_base::beg, which);
+            }
     };
 
     using StringBuffer = BasicStringBuffer<std::iostream>;
     using OStringBuffer = BasicStringBuffer<std::ostream>;
     using IStringBuffer = BasicStringBuffer<std::istream>;
 
-    inline std::ostream & operator<<(std::ostream & os, BasicStringBuffer<std::ostream> & sb)
+    namespace pmr
     {
+        using StringBuffer = BasicStringBuffer<std::iostream, std::pmr::polymorphic_allocator<char>>;
+        using OStringBuffer = BasicStringBuffer<std::ostream, std::pmr::polymorphic_allocator<char>>;
+    }
+
+    template <typename Allocator>
+    inline std::ostream & operator<<(std::ostream & os, BasicStringBuffer<std::ostream, Allocator> & sb)
+    {
+        if ( sb.chunked() )
+        {
+            for ( const auto & span : sb.spans() )
+                os.write(span.data(), std::streamsize(span.size()));
+            return os;
+        }
         return sb.size() > 0 ? os.write(&sb[0], std::streamsize(sb.size())) : os;
     }
 
-    inline std::ostream & operator<<(std::ostream & os, BasicStringBuffer<std::iostream> & sb)
+    template <typename Allocator>
+    inline std::ostream & operator<<(std::ostream & os, BasicStringBuffer<std::iostream, Allocator> & sb)
     {
+        if ( sb.chunked() )
+        {
+            for ( const auto & span : sb.spans() )
+                os.write(span.data(), std::streamsize(span.size()));
+            return os;
+        }
         return sb.size() > 0 ? os.write(&sb[0], std::streamsize(sb.size())) : os;
     }
 
@@ -783,7 +1312,7 @@ namespace RareBufferedStream
                 *sb << is.rdbuf();
                 ((std::basic_ios<char>*)sb.get())->clear();
             }
-            BasicStringBufferPtr(std::ostream & os) : sb(std::make_unique<StringBuffer>()), os(&os) {}
+            BasicStringBufferPtr(std::ostream & os) : sb(std::make_unique<StringBuffer>()), os(&os) { sb->attachSink(os); }
             BasicStringBufferPtr(std::iostream & ios) : sb(std::make_unique<StringBuffer>(ios)), os(&ios)
             {
                 *sb << ios.rdbuf();
@@ -792,8 +1321,7 @@ namespace RareBufferedStream
 
             virtual ~BasicStringBufferPtr()
             {
-                if ( os != nullptr )
-                    *os << *sb;
+                flush();
             }
 
             inline StringBuffer & operator*() const
@@ -809,7 +1337,11 @@ namespace RareBufferedStream
             {
                 if ( os != nullptr )
                 {
-                    *os << *sb;
+                    if ( sb->sinkAttached() ) // Output was streamed to os as it went, write the remainder
+                        sb->detachSink();
+                    else
+                        *os << *sb;
+
                     os = nullptr;
                 }
             }
@@ -825,13 +1357,12 @@ namespace RareBufferedStream
         public:
             BasicStringBufferPtr(OStringBuffer & sb) : sb(&sb, [](OStringBuffer*){}), os(nullptr) {}
             BasicStringBufferPtr(StringBuffer & sb) : sb(std::make_unique<OStringBuffer>()), os(&sb) {}
-            BasicStringBufferPtr(std::ostream & os) : sb(std::make_unique<OStringBuffer>()), os(&os) {}
+            BasicStringBufferPtr(std::ostream & os) : sb(std::make_unique<OStringBuffer>()), os(&os) { sb->attachSink(os); }
             BasicStringBufferPtr(std::iostream & ios) : sb(std::make_unique<OStringBuffer>()), os(&ios) {}
 
             virtual ~BasicStringBufferPtr()
             {
-                if ( os != nullptr )
-                    *os << *sb;
+                flush();
             }
 
             inline OStringBuffer & operator*() const
@@ -847,7 +1378,11 @@ namespace RareBufferedStream
             {
                 if ( os != nullptr )
                 {
-                    *os << *sb;
+                    if ( sb->sinkAttached() ) // Output was streamed to os as it went, write the remainder
+                        sb->detachSink();
+                    else
+                        *os << *sb;
+
                     os = nullptr;
                 }
             }
@@ -867,16 +1402,9 @@ namespace RareBufferedStream
                 *this->sb << sb.rdbuf();
                 ((std::basic_ios<char>*)this->sb.get())->clear();
             }
-            BasicStringBufferPtr(std::istream & is) : sb(std::make_unique<IStringBuffer>(is))
-            {
-                *sb << is.rdbuf();
-                ((std::basic_ios<char>*)sb.get())->clear();
-            }
-            BasicStringBufferPtr(std::iostream & ios) : sb(std::make_unique<IStringBuffer>(ios))
-            {
-                *sb << ios.rdbuf();
-                ((std::basic_ios<char>*)sb.get())->clear();
-            }
+            // Streams are read in windowed mode (see IStringBuffer), so memory use is bounded by the window rather than the source size
+            BasicStringBufferPtr(std::istream & is) : sb(std::make_unique<IStringBuffer>(is, defaultWindowSize)) {}
+            BasicStringBufferPtr(std::iostream & ios) : sb(std::make_unique<IStringBuffer>(ios, defaultWindowSize)) {}
 
             virtual ~BasicStringBufferPtr() {}
 
@@ -890,6 +1418,8 @@ namespace RareBufferedStream
             }
 
         private:
+            static constexpr size_t defaultWindowSize = 64*1024;
+
             mutable std::unique_ptr<IStringBuffer, std::function<void(IStringBuffer*)>> sb;
     };
 
@@ -909,7 +1439,7 @@ namespace RareBufferedStream
     // Functions accepting IStringBufferPtr allow you to pass a reference to one of...
     // IStringbuffer, StringBuffer, std::istream, std::iostream, or another IStringBufferPtr
     // IStringBufferPtrs can be used as though they were pointers to an IStringBuffer
-    // If constructed with std::istream or std::iostream any existing contents will be read in
+    // If constructed with std::istream or std::iostream the contents will be read in a window at a time as they're consumed
     using IStringBufferPtr = const BasicStringBufferPtr<std::istream> &;
 }
 